@@ -105,7 +105,7 @@ void ForEachRecursive(RAI first, RAI last, Function unary,
     }
   }
   // Perform check of task number sufficiency
-  if (((distance / block_size) * 2) + 1 > MTAPI_NODE_MAX_TASKS_DEFAULT) {
+  if (((distance / block_size) * 2) + 1 > node.GetTaskLimit()) {
     EMBB_THROW(embb::base::ErrorException, "Not enough MTAPI tasks available "
                "to perform the parallel foreach loop");
   }
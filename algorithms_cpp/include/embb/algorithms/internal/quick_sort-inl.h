@@ -199,7 +199,7 @@ void QuickSort(RAI first, RAI last, ComparisonFunction comparison,
     if (block_size == 0)
       block_size = 1;
   }
-  if (((distance / block_size) * 2) + 1 > MTAPI_NODE_MAX_TASKS_DEFAULT) {
+  if (((distance / block_size) * 2) + 1 > node.GetTaskLimit()) {
     EMBB_THROW(embb::base::ErrorException,
                "Not enough MTAPI tasks available for performing quick sort");
   }
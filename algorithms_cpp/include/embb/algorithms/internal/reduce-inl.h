@@ -120,7 +120,7 @@ ReturnType ReduceRecursive(RAI first, RAI last, ReturnType neutral,
       if (used_block_size == 0) used_block_size = 1;
   }
 
-  if (((distance / used_block_size) * 2) + 1 > MTAPI_NODE_MAX_TASKS_DEFAULT) {
+  if (((distance / used_block_size) * 2) + 1 > node.GetTaskLimit()) {
     EMBB_THROW(embb::base::ErrorException,
                "Number of computation tasks required in reduction would "
                "exceed MTAPI maximum number of tasks");
@@ -29,6 +29,8 @@
 
 #include <stdint.h>
 
+#include <embb/base/c/internal/bitset.h>
+
 /**
  * \defgroup C_BASE_CORESET Core Set
  *
@@ -53,13 +55,16 @@ extern "C" {
  * For example, the cores of a quad-core system are represented by the set
  * {0,1,2,3}.
  *
+ * A core set holds up to \c EMBB_MAX_CORES cores, which is configured when
+ * building EMBB (CMake option \c EMBB_MAX_CORES, 256 by default).
+ *
  * \see embb_core_count_available()
  */
 #ifdef DOXYGEN
 typedef opaque_type embb_core_set_t;
 #else
 typedef struct embb_core_set_t {
-  uint64_t rep;
+  uint64_t rep[EMBB_BITSET_WORD_COUNT];
 } embb_core_set_t;
 #endif /* else defined(DOXYGEN) */
 
@@ -32,26 +32,35 @@
 #include <stdint.h>
 
 #include <embb/base/c/internal/config.h>
+#include <embb/base/c/internal/cmake_config.h>
+
+/* bitsets are arrays of 64 bit words large enough for EMBB_MAX_CORES bits */
+#define EMBB_BITSET_WORD_COUNT ((EMBB_MAX_CORES + 63) / 64)
 
 EMBB_INLINE void embb_bitset_set(
   uint64_t * that,
   unsigned int bit
   ) {
   assert(NULL != that);
-  assert(64 > bit);
-  *that |= (1ull << bit);
+  assert(EMBB_BITSET_WORD_COUNT * 64 > bit);
+  that[bit / 64] |= (1ull << (bit % 64));
 }
 
 EMBB_INLINE void embb_bitset_set_n(
   uint64_t * that,
   unsigned int count) {
+  unsigned int ii;
   assert(NULL != that);
   assert(0 < count);
-  assert(64 >= count);
-  if (64 == count) {
-    *that = ~0ull;
-  } else {
-    *that = (1ull << count) - 1ull;
+  assert(EMBB_BITSET_WORD_COUNT * 64 >= count);
+  for (ii = 0; ii < EMBB_BITSET_WORD_COUNT; ii++) {
+    if (64 <= count) {
+      that[ii] = ~0ull;
+      count -= 64;
+    } else {
+      that[ii] = (1ull << count) - 1ull;
+      count = 0;
+    }
   }
 }
 
@@ -60,50 +69,96 @@ EMBB_INLINE void embb_bitset_clear(
   unsigned int bit
   ) {
   assert(NULL != that);
-  assert(64 > bit);
-  *that &= ~(1ull << bit);
+  assert(EMBB_BITSET_WORD_COUNT * 64 > bit);
+  that[bit / 64] &= ~(1ull << (bit % 64));
 }
 
 EMBB_INLINE void embb_bitset_clear_all(
   uint64_t * that
   ) {
+  unsigned int ii;
   assert(NULL != that);
-  *that = 0ull;
+  for (ii = 0; ii < EMBB_BITSET_WORD_COUNT; ii++) {
+    that[ii] = 0ull;
+  }
 }
 
 EMBB_INLINE unsigned int embb_bitset_is_set(
   uint64_t const * that,
   unsigned int bit
   ) {
-  return (unsigned int)((*that & (1ull << bit)) ? 1 : 0);
+  assert(NULL != that);
+  if (EMBB_BITSET_WORD_COUNT * 64 <= bit) {
+    return 0;
+  }
+  return (unsigned int)((that[bit / 64] & (1ull << (bit % 64))) ? 1 : 0);
+}
+
+EMBB_INLINE unsigned int embb_bitset_is_empty(
+  uint64_t const * that
+  ) {
+  unsigned int ii;
+  assert(NULL != that);
+  for (ii = 0; ii < EMBB_BITSET_WORD_COUNT; ii++) {
+    if (0ull != that[ii]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+EMBB_INLINE unsigned int embb_bitset_is_equal(
+  uint64_t const * that,
+  uint64_t const * other
+  ) {
+  unsigned int ii;
+  assert(NULL != that);
+  assert(NULL != other);
+  for (ii = 0; ii < EMBB_BITSET_WORD_COUNT; ii++) {
+    if (that[ii] != other[ii]) {
+      return 0;
+    }
+  }
+  return 1;
 }
 
 EMBB_INLINE void embb_bitset_intersect(
   uint64_t * that,
-  uint64_t mask
+  uint64_t const * mask
   ) {
+  unsigned int ii;
   assert(NULL != that);
-  *that &= mask;
+  assert(NULL != mask);
+  for (ii = 0; ii < EMBB_BITSET_WORD_COUNT; ii++) {
+    that[ii] &= mask[ii];
+  }
 }
 
 EMBB_INLINE void embb_bitset_union(
   uint64_t * that,
-  uint64_t mask
+  uint64_t const * mask
   ) {
+  unsigned int ii;
   assert(NULL != that);
-  *that |= mask;
+  assert(NULL != mask);
+  for (ii = 0; ii < EMBB_BITSET_WORD_COUNT; ii++) {
+    that[ii] |= mask[ii];
+  }
 }
 
 EMBB_INLINE unsigned int embb_bitset_count(
   uint64_t const * that
   ) {
   unsigned int count = 0;
-  uint64_t mask = 1ull;
-  for (unsigned int ii = 0; ii < 64; ii++) {
-    if ((*that & mask) > 0) {
+  unsigned int ii;
+  assert(NULL != that);
+  for (ii = 0; ii < EMBB_BITSET_WORD_COUNT; ii++) {
+    uint64_t word = that[ii];
+    /* clear the lowest set bit until none is left */
+    while (0ull != word) {
+      word &= word - 1ull;
       count++;
     }
-    mask <<= 1;
   }
   return count;
 }
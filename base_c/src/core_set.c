@@ -81,9 +81,9 @@ void embb_core_set_init(embb_core_set_t* core_set, int initializer) {
   }
 
   if (initializer == 0) {
-    embb_bitset_clear_all(&core_set->rep);
+    embb_bitset_clear_all(core_set->rep);
   } else {
-    embb_bitset_set_n(&core_set->rep, embb_core_count_available());
+    embb_bitset_set_n(core_set->rep, embb_core_count_available());
   }
 }
 
@@ -105,12 +105,12 @@ unsigned int embb_core_count_available() {
 
 void embb_core_set_init(embb_core_set_t* core_set, int initializer) {
   assert(core_set != NULL);
-  assert(embb_core_count_available() < 64 &&
-    "Core sets are only supported up to 64 processors!");
+  assert(embb_core_count_available() <= EMBB_MAX_CORES &&
+    "Core sets are only supported up to EMBB_MAX_CORES processors!");
   if (initializer == 0) {
-    embb_bitset_clear_all(&core_set->rep);
+    embb_bitset_clear_all(core_set->rep);
   } else {
-    embb_bitset_set_n(&core_set->rep, embb_core_count_available());
+    embb_bitset_set_n(core_set->rep, embb_core_count_available());
   }
 }
 
@@ -119,31 +119,31 @@ void embb_core_set_init(embb_core_set_t* core_set, int initializer) {
 void embb_core_set_add(embb_core_set_t* core_set, unsigned int core_number) {
   assert(core_set != NULL);
   assert(core_number < embb_core_count_available());
-  embb_bitset_set(&core_set->rep, core_number);
+  embb_bitset_set(core_set->rep, core_number);
 }
 
 void embb_core_set_remove(embb_core_set_t* core_set, unsigned int core_number) {
   assert(core_set != NULL);
   assert(core_number < embb_core_count_available());
-  embb_bitset_clear(&core_set->rep, core_number);
+  embb_bitset_clear(core_set->rep, core_number);
 }
 
 int embb_core_set_contains(const embb_core_set_t* core_set,
   unsigned int core_number) {
   assert(core_set != NULL);
   assert(core_number < embb_core_count_available());
-  return (int)(embb_bitset_is_set(&core_set->rep, core_number));
+  return (int)(embb_bitset_is_set(core_set->rep, core_number));
 }
 
 void embb_core_set_intersection(embb_core_set_t* set1,
                                 const embb_core_set_t* set2) {
-  embb_bitset_intersect(&set1->rep, set2->rep);
+  embb_bitset_intersect(set1->rep, set2->rep);
 }
 
 void embb_core_set_union(embb_core_set_t* set1, const embb_core_set_t* set2) {
-  embb_bitset_union(&set1->rep, set2->rep);
+  embb_bitset_union(set1->rep, set2->rep);
 }
 
 unsigned int embb_core_set_count(const embb_core_set_t* core_set) {
-  return embb_bitset_count(&core_set->rep);
+  return embb_bitset_count(core_set->rep);
 }
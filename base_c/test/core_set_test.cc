@@ -26,6 +26,7 @@
 
 #include <core_set_test.h>
 #include <embb/base/c/core_set.h>
+#include <embb/base/c/internal/bitset.h>
 
 namespace embb {
 namespace base {
@@ -33,6 +34,7 @@ namespace test {
 
 CoreSetTest::CoreSetTest() {
   CreateUnit("Test all").Add(&CoreSetTest::Test, this);
+  CreateUnit("Test many cores").Add(&CoreSetTest::TestManyCores, this);
 }
 
 void CoreSetTest::Test() {
@@ -75,6 +77,56 @@ void CoreSetTest::Test() {
   PT_EXPECT_EQ(cores, available_cores);
 }
 
+void CoreSetTest::TestManyCores() {
+  const unsigned int max_cores = EMBB_MAX_CORES;
+  const unsigned int zero = 0;
+  const unsigned int one = 1;
+  uint64_t set[EMBB_BITSET_WORD_COUNT];
+  uint64_t all[EMBB_BITSET_WORD_COUNT];
+
+  if (max_cores <= 64) {
+    // Built for a single word only
+    return;
+  }
+
+  // Single bits on both sides of word boundaries
+  embb_bitset_clear_all(set);
+  PT_EXPECT_EQ(embb_bitset_is_empty(set), one);
+  embb_bitset_set(set, 63);
+  embb_bitset_set(set, 64);
+  embb_bitset_set(set, max_cores - 1);
+  PT_EXPECT_EQ(embb_bitset_count(set), 3u);
+  PT_EXPECT_EQ(embb_bitset_is_set(set, 62), zero);
+  PT_EXPECT_EQ(embb_bitset_is_set(set, 63), one);
+  PT_EXPECT_EQ(embb_bitset_is_set(set, 64), one);
+  PT_EXPECT_EQ(embb_bitset_is_set(set, 65), zero);
+  PT_EXPECT_EQ(embb_bitset_is_set(set, max_cores - 1), one);
+  embb_bitset_clear(set, 64);
+  PT_EXPECT_EQ(embb_bitset_is_set(set, 64), zero);
+  PT_EXPECT_EQ(embb_bitset_count(set), 2u);
+
+  // First n bits spanning several words
+  for (unsigned int count = 1; count <= max_cores; count += 37) {
+    embb_bitset_set_n(all, count);
+    PT_EXPECT_EQ(embb_bitset_count(all), count);
+    PT_EXPECT_EQ(embb_bitset_is_set(all, count - 1), one);
+    if (count < max_cores) {
+      PT_EXPECT_EQ(embb_bitset_is_set(all, count), zero);
+    }
+  }
+
+  // Intersection, union and comparison
+  embb_bitset_set_n(all, max_cores);
+  PT_EXPECT_EQ(embb_bitset_count(all), max_cores);
+  embb_bitset_intersect(all, set);
+  PT_EXPECT_EQ(embb_bitset_is_equal(all, set), one);
+  embb_bitset_clear_all(all);
+  embb_bitset_set(all, 100);
+  embb_bitset_union(all, set);
+  PT_EXPECT_EQ(embb_bitset_count(all), 3u);
+  PT_EXPECT_EQ(embb_bitset_is_equal(all, set), zero);
+}
+
 } // namespace test
 } // namespace base
 } // namespace embb
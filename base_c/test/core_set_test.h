@@ -45,6 +45,12 @@ class CoreSetTest : public partest::TestCase {
    * Tests all functionalities.
    */
   void Test();
+
+  /**
+   * Tests the bitset representation across word boundaries, independent of
+   * the number of cores of the test machine.
+   */
+  void TestManyCores();
 };
 
 } // namespace test
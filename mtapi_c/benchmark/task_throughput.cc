@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Measures how many small tasks per second the scheduler runs. Each task
+ * starts two children and waits for them until a binary tree of the given
+ * depth is complete, so workers constantly push to and steal from each
+ * other's queues and update task states. Compare the numbers before and after
+ * layout changes to see how much false sharing between workers costs.
+ *
+ * Usage: mtapi_task_throughput [depth] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/atomic.h>
+#include <embb/base/c/time.h>
+
+#define THROUGHPUT_DOMAIN_ID 1
+#define THROUGHPUT_NODE_ID 1
+#define JOB_THROUGHPUT 1
+#define MAX_DEPTH 20
+
+static int depths[MAX_DEPTH + 1];
+static embb_atomic_int tasks_done;
+
+static void ThroughputAction(
+  const void* args,
+  mtapi_size_t arg_size,
+  void* result_buffer,
+  mtapi_size_t result_buffer_size,
+  const void* node_local_data,
+  mtapi_size_t node_local_data_size,
+  mtapi_task_context_t* task_context) {
+  int depth = *reinterpret_cast<const int*>(args);
+
+  if (0 < depth) {
+    mtapi_status_t status;
+    mtapi_job_hndl_t job =
+      mtapi_job_get(JOB_THROUGHPUT, THROUGHPUT_DOMAIN_ID, &status);
+    mtapi_task_hndl_t children[2];
+    mtapi_boolean_t started[2];
+    int child;
+    for (child = 0; child < 2; child++) {
+      children[child] = mtapi_task_start(MTAPI_TASK_ID_NONE, job,
+        &depths[depth - 1], sizeof(int), MTAPI_NULL, 0,
+        MTAPI_DEFAULT_TASK_ATTRIBUTES, MTAPI_GROUP_NONE, &status);
+      started[child] = (MTAPI_SUCCESS == status) ? MTAPI_TRUE : MTAPI_FALSE;
+      if (!started[child]) {
+        /* out of task records, keep the count right by running inline */
+        ThroughputAction(&depths[depth - 1], arg_size, result_buffer,
+          result_buffer_size, node_local_data, node_local_data_size,
+          task_context);
+      }
+    }
+    for (child = 0; child < 2; child++) {
+      if (started[child]) {
+        mtapi_task_wait(children[child], MTAPI_INFINITE, &status);
+      }
+    }
+  }
+
+  embb_atomic_fetch_and_add_int(&tasks_done, 1);
+}
+
+static double SecondsBetween(embb_time_t const * start,
+  embb_time_t const * end) {
+  return static_cast<double>(end->seconds - start->seconds) +
+    (static_cast<double>(end->nanoseconds) -
+     static_cast<double>(start->nanoseconds)) / 1e9;
+}
+
+int main(int argc, char** argv) {
+  mtapi_node_attributes_t node_attr;
+  mtapi_info_t info;
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_uint_t tree_size;
+  mtapi_uint_t max_tasks;
+  int depth = 16;
+  int rounds = 10;
+  int ii;
+  double best = 0.0;
+
+  if (1 < argc) depth = atoi(argv[1]);
+  if (2 < argc) rounds = atoi(argv[2]);
+  if (depth < 1 || depth > MAX_DEPTH || rounds < 1) {
+    printf("usage: %s [depth 1..%d] [rounds]\n", argv[0], MAX_DEPTH);
+    return 1;
+  }
+  for (ii = 0; ii <= MAX_DEPTH; ii++) {
+    depths[ii] = ii;
+  }
+  tree_size = (1u << (depth + 1)) - 1;
+  /* the task pool never hands out id 0 */
+  max_tasks = tree_size + 1;
+
+  /* the whole tree may be alive at once */
+  mtapi_nodeattr_init(&node_attr, &status);
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_MAX_TASKS,
+    &max_tasks, MTAPI_NODE_MAX_TASKS_SIZE, &status);
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_QUEUE_LIMIT,
+    &tree_size, MTAPI_NODE_QUEUE_LIMIT_SIZE, &status);
+  mtapi_initialize(THROUGHPUT_DOMAIN_ID, THROUGHPUT_NODE_ID,
+    &node_attr, &info, &status);
+  if (MTAPI_SUCCESS != status) {
+    printf("could not initialize mtapi\n");
+    return 1;
+  }
+
+  action = mtapi_action_create(JOB_THROUGHPUT, ThroughputAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  job = mtapi_job_get(JOB_THROUGHPUT, THROUGHPUT_DOMAIN_ID, &status);
+
+  printf("workers: %u, tasks per round: %u\n",
+    info.hardware_concurrency, tree_size);
+
+  for (ii = 0; ii < rounds; ii++) {
+    embb_time_t start, end;
+    double seconds;
+    double rate;
+    mtapi_task_hndl_t task;
+
+    embb_atomic_store_int(&tasks_done, 0);
+    embb_time_now(&start);
+    task = mtapi_task_start(MTAPI_TASK_ID_NONE, job, &depths[depth],
+      sizeof(int), MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE, &status);
+    mtapi_task_wait(task, MTAPI_INFINITE, &status);
+    embb_time_now(&end);
+    if (static_cast<int>(tree_size) != embb_atomic_load_int(&tasks_done)) {
+      printf("round %d: only %d of %u tasks ran\n", ii,
+        embb_atomic_load_int(&tasks_done), tree_size);
+      break;
+    }
+
+    seconds = SecondsBetween(&start, &end);
+    rate = static_cast<double>(tree_size) / seconds;
+    if (rate > best) best = rate;
+    printf("round %d: %.3f s, %.0f tasks/s\n", ii, seconds, rate);
+  }
+  printf("best: %.0f tasks/s\n", best);
+
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  mtapi_finalize(&status);
+
+  return 0;
+}
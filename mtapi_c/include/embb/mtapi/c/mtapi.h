@@ -318,10 +318,19 @@ struct mtapi_info_struct {
 typedef struct mtapi_info_struct mtapi_info_t;
 
 /**
- * Core affinity type.
+ * Core affinity mask, one bit per worker thread. Holds up to
+ * \c EMBB_MAX_CORES workers.
  * \ingroup CORE_AFFINITY_MASKS
  */
-typedef mtapi_uint64_t mtapi_affinity_t;
+struct mtapi_affinity_struct {
+  mtapi_uint64_t rep[EMBB_BITSET_WORD_COUNT];
+};
+
+/**
+ * Core affinity type.
+ * \memberof mtapi_affinity_struct
+ */
+typedef struct mtapi_affinity_struct mtapi_affinity_t;
 
 
 /* ---- BASIC enumerations ------------------------------------------------- */
@@ -527,8 +536,23 @@ enum mtapi_node_attributes_enum {
                                             the node */
   MTAPI_NODE_MAX_ACTIONS_PER_JOB,      /**< maximum number of actions in a job
                                             allowed by the node */
-  MTAPI_NODE_MAX_PRIORITIES            /**< maximum number of priorities
+  MTAPI_NODE_MAX_PRIORITIES,           /**< maximum number of priorities
                                             allowed by the node */
+  MTAPI_NODE_SCHEDULER_MODE,           /**< work stealing strategy used by
+                                            the workers of the node */
+  MTAPI_NODE_IDLE_SPIN_COUNT,          /**< number of times an idle worker
+                                            looks for work before parking */
+  MTAPI_NODE_IDLE_SPIN_PAUSE,          /**< idle workers spin using pause
+                                            instructions instead of yielding
+                                            the thread */
+  MTAPI_NODE_IDLE_PARK_TIMEOUT,        /**< time in milliseconds a parked
+                                            worker sleeps before looking for
+                                            work again, MTAPI_INFINITE parks
+                                            until woken up */
+  MTAPI_NODE_IDLE_ADAPTIVE             /**< adapt the number of spins to the
+                                            recent task arrival rate, using
+                                            MTAPI_NODE_IDLE_SPIN_COUNT as the
+                                            upper bound */
 };
 /** size of the \a MTAPI_NODE_CORE_AFFINITY attribute */
 #define MTAPI_NODE_CORE_AFFINITY_SIZE sizeof(embb_core_set_t)
@@ -552,11 +576,31 @@ enum mtapi_node_attributes_enum {
 #define MTAPI_NODE_MAX_ACTIONS_PER_JOB_SIZE sizeof(mtapi_uint_t)
 /** size of the \a MTAPI_NODE_MAX_PRIORITIES attribute */
 #define MTAPI_NODE_MAX_PRIORITIES_SIZE sizeof(mtapi_uint_t)
+/** size of the \a MTAPI_NODE_SCHEDULER_MODE attribute */
+#define MTAPI_NODE_SCHEDULER_MODE_SIZE sizeof(mtapi_uint_t)
+/** size of the \a MTAPI_NODE_IDLE_SPIN_COUNT attribute */
+#define MTAPI_NODE_IDLE_SPIN_COUNT_SIZE sizeof(mtapi_uint_t)
+/** size of the \a MTAPI_NODE_IDLE_SPIN_PAUSE attribute */
+#define MTAPI_NODE_IDLE_SPIN_PAUSE_SIZE sizeof(mtapi_boolean_t)
+/** size of the \a MTAPI_NODE_IDLE_PARK_TIMEOUT attribute */
+#define MTAPI_NODE_IDLE_PARK_TIMEOUT_SIZE sizeof(mtapi_timeout_t)
+/** size of the \a MTAPI_NODE_IDLE_ADAPTIVE attribute */
+#define MTAPI_NODE_IDLE_ADAPTIVE_SIZE sizeof(mtapi_boolean_t)
 
 /* example attribute value */
 #define MTAPI_NODE_TYPE_SMP 1
 #define MTAPI_NODE_TYPE_DSP 2
 
+/** steal from victims in order, higher priorities first */
+#define MTAPI_NODE_SCHEDULER_MODE_VHPF 0
+/** steal only if all local queues are empty */
+#define MTAPI_NODE_SCHEDULER_MODE_LF 1
+/** like \a MTAPI_NODE_SCHEDULER_MODE_VHPF, but start at a random victim */
+#define MTAPI_NODE_SCHEDULER_MODE_RANDOM_VHPF 2
+/** like \a MTAPI_NODE_SCHEDULER_MODE_VHPF, but steal up to half of the
+    victim's tasks at once */
+#define MTAPI_NODE_SCHEDULER_MODE_HALF_VHPF 3
+
 /** task attributes */
 enum mtapi_task_attributes_enum {
   MTAPI_TASK_DETACHED,                 /**< task is detached, i.e., the runtime
@@ -650,6 +694,12 @@ struct mtapi_node_attributes_struct {
   mtapi_uint_t max_actions_per_job;    /**< stores
                                             MTAPI_NODE_MAX_ACTIONS_PER_JOB */
   mtapi_uint_t max_priorities;         /**< stores MTAPI_NODE_MAX_PRIORITIES */
+  mtapi_uint_t scheduler_mode;         /**< stores MTAPI_NODE_SCHEDULER_MODE */
+  mtapi_uint_t idle_spin_count;        /**< stores MTAPI_NODE_IDLE_SPIN_COUNT */
+  mtapi_boolean_t idle_spin_pause;     /**< stores MTAPI_NODE_IDLE_SPIN_PAUSE */
+  mtapi_timeout_t idle_park_timeout;   /**< stores
+                                            MTAPI_NODE_IDLE_PARK_TIMEOUT */
+  mtapi_boolean_t idle_adaptive;       /**< stores MTAPI_NODE_IDLE_ADAPTIVE */
 };
 
 /**
@@ -898,6 +948,9 @@ extern mtapi_group_hndl_t MTAPI_GROUP_NONE;
 #define MTAPI_NODE_MAX_JOBS_DEFAULT 256
 #define MTAPI_NODE_MAX_ACTIONS_PER_JOB_DEFAULT 4
 #define MTAPI_NODE_MAX_PRIORITIES_DEFAULT 4
+#define MTAPI_NODE_SCHEDULER_MODE_DEFAULT MTAPI_NODE_SCHEDULER_MODE_VHPF
+#define MTAPI_NODE_IDLE_SPIN_COUNT_DEFAULT 1024
+#define MTAPI_NODE_IDLE_PARK_TIMEOUT_DEFAULT 10
 
 #define MTAPI_JOB_ID_INVALID 0
 #define MTAPI_DOMAIN_ID_INVALID 0
@@ -908,6 +961,9 @@ extern mtapi_group_hndl_t MTAPI_GROUP_NONE;
 #define MTAPI_QUEUE_ID_NONE 0
 #define MTAPI_ACTION_ID_NONE 0
 
+/** size of the result storage every task keeps for itself */
+#define MTAPI_TASK_RESULT_INLINE_SIZE 64
+
 
 /* ---- RUNTIME INIT & SHUTDOWN -------------------------------------------- */
 
@@ -991,6 +1047,43 @@ void mtapi_nodeattr_init(
  *     <td>\c mtapi_uint_t</td>
  *     <td>(none)</td>
  *   </tr>
+ *   <tr>
+ *     <td>\c MTAPI_NODE_SCHEDULER_MODE</td>
+ *     <td>Work stealing strategy, one of \c MTAPI_NODE_SCHEDULER_MODE_VHPF,
+ *         \c MTAPI_NODE_SCHEDULER_MODE_LF,
+ *         \c MTAPI_NODE_SCHEDULER_MODE_RANDOM_VHPF or
+ *         \c MTAPI_NODE_SCHEDULER_MODE_HALF_VHPF.</td>
+ *     <td>\c mtapi_uint_t</td>
+ *     <td>\c MTAPI_NODE_SCHEDULER_MODE_VHPF</td>
+ *   </tr>
+ *   <tr>
+ *     <td>\c MTAPI_NODE_IDLE_SPIN_COUNT</td>
+ *     <td>Number of times an idle worker looks for work before it parks.</td>
+ *     <td>\c mtapi_uint_t</td>
+ *     <td>1024</td>
+ *   </tr>
+ *   <tr>
+ *     <td>\c MTAPI_NODE_IDLE_SPIN_PAUSE</td>
+ *     <td>Idle workers spin with pause instructions instead of yielding
+ *         their thread.</td>
+ *     <td>\c mtapi_boolean_t</td>
+ *     <td>\c MTAPI_FALSE</td>
+ *   </tr>
+ *   <tr>
+ *     <td>\c MTAPI_NODE_IDLE_PARK_TIMEOUT</td>
+ *     <td>Milliseconds a parked worker sleeps before it looks for work again,
+ *         \c MTAPI_INFINITE parks until new work arrives.</td>
+ *     <td>\c mtapi_timeout_t</td>
+ *     <td>10</td>
+ *   </tr>
+ *   <tr>
+ *     <td>\c MTAPI_NODE_IDLE_ADAPTIVE</td>
+ *     <td>Spin longer while tasks arrive frequently and park sooner while
+ *         they do not, \c MTAPI_NODE_IDLE_SPIN_COUNT is the upper
+ *         bound.</td>
+ *     <td>\c mtapi_boolean_t</td>
+ *     <td>\c MTAPI_FALSE</td>
+ *   </tr>
  * </table>
  *
  * On success, \c *status is set to \c MTAPI_SUCCESS. On error, \c *status is
@@ -2719,6 +2812,12 @@ void mtapi_taskattr_set(
  * task group. Otherwise \c group must be a group handle obtained by a previous
  * call to mtapi_group_create().
  *
+ * As an extension to the MTAPI specification, the task keeps the result
+ * itself if \c result_buffer is \c MTAPI_NULL and the results of all
+ * instances take at most \c MTAPI_TASK_RESULT_INLINE_SIZE bytes. The action
+ * function then gets a pointer to \c result_size zeroed bytes inside the
+ * task, which can be read with mtapi_task_get_result().
+ *
  * On success, a task handle is returned and \c *status is set to
  * \c MTAPI_SUCCESS. On error, \c *status is set to the appropriate error
  * defined below.
@@ -2731,7 +2830,7 @@ void mtapi_taskattr_set(
  * \c MTAPI_ERR_JOB_INVALID   | The associated job is not valid.
  *
  * \see mtapi_job_get(), mtapi_taskattr_init(), mtapi_taskattr_set(),
- *      mtapi_group_create()
+ *      mtapi_group_create(), mtapi_task_get_result()
  *
  * \returns Handle to newly started task, invalid handle on error
  * \threadsafe
@@ -2752,6 +2851,113 @@ mtapi_task_hndl_t mtapi_task_start(
                                              may be \c MTAPI_NULL */
   );
 
+/**
+ * This function schedules \c count tasks of the same job for execution.
+ *
+ * This is an extension to the MTAPI specification. It behaves like
+ * \c count calls of mtapi_task_start() with \c MTAPI_TASK_ID_NONE, but
+ * validates the job, attributes and group only once, spreads the tasks
+ * across the workers in a single pass and wakes up each sleeping worker at
+ * most once.
+ *
+ * Task \c i gets \c arguments_size bytes of arguments starting at
+ * \c arguments + \c i * \c arguments_size and writes its result of
+ * \c result_size bytes to \c result_buffer + \c i * \c result_size. All
+ * tasks share the given \c attributes and \c group.
+ *
+ * If the attributes set \c MTAPI_TASK_INSTANCES to \c n, every task writes
+ * \c n results like a task started by mtapi_task_start(). The results of
+ * task \c i then start at \c result_buffer + \c i * \c n * \c result_size,
+ * so the buffer has to hold \c count * \c n results.
+ *
+ * If \c tasks is not \c MTAPI_NULL, it must point to an array of \c count
+ * task handles that receives the handles of the started tasks. Handles of
+ * detached tasks and of tasks that could not be started are invalid.
+ *
+ * Returns the number of tasks started. If not all tasks could be started,
+ * the first ones were started and \c *status is set to
+ * \c MTAPI_ERR_TASK_LIMIT. On other errors no task is started.
+ * Error code                 | Description
+ * -------------------------- | -----------------------------------------------
+ * \c MTAPI_ERR_TASK_LIMIT    | Exceeded maximum number of tasks allowed.
+ * \c MTAPI_ERR_NODE_NOTINIT  | The calling node is not initialized.
+ * \c MTAPI_ERR_PARAMETER     | Invalid attributes parameter.
+ * \c MTAPI_ERR_JOB_INVALID   | The associated job is not valid.
+ * \c MTAPI_ERR_ACTION_INVALID| The job has no valid action.
+ *
+ * \see mtapi_task_start()
+ *
+ * \returns Number of tasks started
+ * \threadsafe
+ * \ingroup TASKS
+ */
+mtapi_uint_t mtapi_task_start_batch(
+  MTAPI_IN mtapi_job_hndl_t job,       /**< [in] Job handle */
+  MTAPI_IN void* arguments,            /**< [in] Pointer to the arguments of
+                                            all tasks */
+  MTAPI_IN mtapi_size_t arguments_size,/**< [in] Size of the arguments of
+                                            one task */
+  MTAPI_OUT void* result_buffer,       /**< [out] Pointer to the result
+                                            buffers of all tasks */
+  MTAPI_IN mtapi_size_t result_size,   /**< [in] Size of one result */
+  MTAPI_IN mtapi_task_attributes_t* attributes,
+                                       /**< [in] Pointer to attributes */
+  MTAPI_IN mtapi_group_hndl_t group,   /**< [in] Group handle, may be
+                                            \c MTAPI_GROUP_NONE */
+  MTAPI_IN mtapi_uint_t count,         /**< [in] Number of tasks to start */
+  MTAPI_OUT mtapi_task_hndl_t* tasks,  /**< [out] Array of \c count task
+                                            handles, may be \c MTAPI_NULL */
+  MTAPI_OUT mtapi_status_t* status     /**< [out] Pointer to error code,
+                                             may be \c MTAPI_NULL */
+  );
+
+/**
+ * This function starts a task once the task \c predecessor has finished.
+ *
+ * This is an extension to the MTAPI specification. It behaves like
+ * mtapi_task_start(), but the new task is kept back until \c predecessor
+ * has completed, been cancelled or failed, so a chain of tasks can be set
+ * up without blocking in mtapi_task_wait(). If \c predecessor has finished
+ * already, the new task is scheduled right away. The returned handle can be
+ * waited for, cancelled and used as predecessor like any other task handle.
+ *
+ * \c predecessor must not be deleted by mtapi_task_wait() before this
+ * function returns.
+ *
+ * On success, \c *status is set to \c MTAPI_SUCCESS. On error, \c *status
+ * is set to the appropriate error defined below.
+ * Error code                 | Description
+ * -------------------------- | -----------------------------------------------
+ * \c MTAPI_ERR_TASK_INVALID  | Predecessor is not a valid task handle.
+ * \c MTAPI_ERR_TASK_LIMIT    | Exceeded maximum number of tasks allowed.
+ * \c MTAPI_ERR_NODE_NOTINIT  | The calling node is not initialized.
+ * \c MTAPI_ERR_PARAMETER     | Invalid attributes parameter.
+ * \c MTAPI_ERR_GROUP_INVALID | Argument is not a valid group handle.
+ * \c MTAPI_ERR_JOB_INVALID   | The associated job is not valid.
+ *
+ * \see mtapi_task_start(), mtapi_group_continue_with()
+ *
+ * \returns Handle to newly started task, invalid handle on error
+ * \threadsafe
+ * \ingroup TASKS
+ */
+mtapi_task_hndl_t mtapi_task_continue_with(
+  MTAPI_IN mtapi_task_hndl_t predecessor,
+                                       /**< [in] Task to wait for */
+  MTAPI_IN mtapi_task_id_t task_id,    /**< [in] Task id */
+  MTAPI_IN mtapi_job_hndl_t job,       /**< [in] Job handle */
+  MTAPI_IN void* arguments,            /**< [in] Pointer to arguments */
+  MTAPI_IN mtapi_size_t arguments_size,/**< [in] Size of arguments */
+  MTAPI_OUT void* result_buffer,       /**< [out] Pointer to result buffer */
+  MTAPI_IN mtapi_size_t result_size,   /**< [in] Size of one result */
+  MTAPI_IN mtapi_task_attributes_t* attributes,
+                                       /**< [in] Pointer to attributes */
+  MTAPI_IN mtapi_group_hndl_t group,   /**< [in] Group handle, may be
+                                            \c MTAPI_GROUP_NONE */
+  MTAPI_OUT mtapi_status_t* status     /**< [out] Pointer to error code,
+                                             may be \c MTAPI_NULL */
+  );
+
 /**
  * This function schedules a task for execution using a queue.
  *
@@ -3001,6 +3207,35 @@ void mtapi_task_wait(
                                             may be \c MTAPI_NULL */
   );
 
+/**
+ * This function waits for the completion of the specified task and returns
+ * its result buffer.
+ *
+ * This is an extension to the MTAPI specification. It waits like
+ * mtapi_task_wait(), executing other tasks meanwhile if called from a worker
+ * thread, but the task is not deleted afterwards. This keeps the result
+ * stored inside the task valid until the task is released by a call to
+ * mtapi_task_wait(), which returns at once for a finished task.
+ *
+ * On success, \c *status is set to \c MTAPI_SUCCESS. Otherwise \c *status is
+ * set to the error code mtapi_task_wait() would return, the task is not
+ * released in any case.
+ *
+ * \see mtapi_task_start(), mtapi_task_wait()
+ *
+ * \returns Pointer to the result buffer of the task, \c MTAPI_NULL if the
+ *          task has not finished or is invalid
+ * \threadsafe
+ * \ingroup TASKS
+ */
+void* mtapi_task_get_result(
+  MTAPI_IN mtapi_task_hndl_t task,     /**< [in] Task handle */
+  MTAPI_IN mtapi_timeout_t timeout,    /**< [in] Timeout duration in
+                                            milliseconds */
+  MTAPI_OUT mtapi_status_t* status     /**< [out] Pointer to error code,
+                                            may be \c MTAPI_NULL */
+  );
+
 
 /* ---- TASK GROUPS -------------------------------------------------------- */
 
@@ -3459,6 +3694,54 @@ void mtapi_group_delete(
                                             may be \c MTAPI_NULL */
   );
 
+/**
+ * This function starts a task once all tasks of \c predecessor_group have
+ * finished.
+ *
+ * This is an extension to the MTAPI specification. It behaves like
+ * mtapi_task_start(), but the new task is kept back until the group has no
+ * unfinished tasks left, so no thread has to block in
+ * mtapi_group_wait_all(). If the group has no unfinished tasks, the new
+ * task is scheduled right away. Tasks that are added to the group later on
+ * do not delay continuations that were started already, and a continuation
+ * added afterwards waits for them.
+ *
+ * The group is not deleted by this function, its tasks still have to be
+ * collected with mtapi_group_wait_all() or mtapi_group_wait_any().
+ *
+ * On success, \c *status is set to \c MTAPI_SUCCESS. On error, \c *status
+ * is set to the appropriate error defined below.
+ * Error code                 | Description
+ * -------------------------- | -----------------------------------------------
+ * \c MTAPI_ERR_GROUP_INVALID | Argument is not a valid group handle.
+ * \c MTAPI_ERR_TASK_LIMIT    | Exceeded maximum number of tasks allowed.
+ * \c MTAPI_ERR_NODE_NOTINIT  | The calling node is not initialized.
+ * \c MTAPI_ERR_PARAMETER     | Invalid attributes parameter.
+ * \c MTAPI_ERR_JOB_INVALID   | The associated job is not valid.
+ *
+ * \see mtapi_task_start(), mtapi_task_continue_with()
+ *
+ * \returns Handle to newly started task, invalid handle on error
+ * \threadsafe
+ * \ingroup TASK_GROUPS
+ */
+mtapi_task_hndl_t mtapi_group_continue_with(
+  MTAPI_IN mtapi_group_hndl_t predecessor_group,
+                                       /**< [in] Group to wait for */
+  MTAPI_IN mtapi_task_id_t task_id,    /**< [in] Task id */
+  MTAPI_IN mtapi_job_hndl_t job,       /**< [in] Job handle */
+  MTAPI_IN void* arguments,            /**< [in] Pointer to arguments */
+  MTAPI_IN mtapi_size_t arguments_size,/**< [in] Size of arguments */
+  MTAPI_OUT void* result_buffer,       /**< [out] Pointer to result buffer */
+  MTAPI_IN mtapi_size_t result_size,   /**< [in] Size of one result */
+  MTAPI_IN mtapi_task_attributes_t* attributes,
+                                       /**< [in] Pointer to attributes */
+  MTAPI_IN mtapi_group_hndl_t group,   /**< [in] Group handle, may be
+                                            \c MTAPI_GROUP_NONE */
+  MTAPI_OUT mtapi_status_t* status     /**< [out] Pointer to error code,
+                                             may be \c MTAPI_NULL */
+  );
+
 
 /**
  * \internal
@@ -29,6 +29,7 @@
 #include <embb/mtapi/c/mtapi.h>
 #include <embb/base/c/duration.h>
 #include <embb/base/c/time.h>
+#include <embb/base/c/internal/bitset.h>
 
 #include <embb_mtapi_job_t.h>
 #include <embb_mtapi_log.h>
@@ -54,15 +55,40 @@ void embb_mtapi_action_initialize(embb_mtapi_action_t* that) {
   that->domain_id = MTAPI_DOMAIN_ID_INVALID;
   that->node_id = MTAPI_NODE_ID_INVALID;
   that->enabled = MTAPI_FALSE;
+  that->deleted = MTAPI_FALSE;
   that->node_local_data = NULL;
   that->node_local_data_size = 0;
   embb_atomic_store_int(&that->num_tasks, 0);
+  embb_atomic_store_unsigned_long_long(&that->execution_time, 0);
 }
 
 void embb_mtapi_action_finalize(embb_mtapi_action_t* that) {
   embb_mtapi_action_initialize(that);
 }
 
+void embb_mtapi_action_add_execution_time(
+  embb_mtapi_action_t* that,
+  unsigned long long nanoseconds) {
+  unsigned long long average;
+  assert(MTAPI_NULL != that);
+
+  /* races between workers only lose single samples, which is fine for
+     an estimate */
+  average = embb_atomic_load_unsigned_long_long(&that->execution_time);
+  if (0 == average) {
+    average = nanoseconds;
+  } else if (nanoseconds > average) {
+    average += (nanoseconds - average) / 8;
+  } else {
+    average -= (average - nanoseconds) / 8;
+  }
+  /* 0 is reserved for "not measured yet" */
+  if (0 == average) {
+    average = 1;
+  }
+  embb_atomic_store_unsigned_long_long(&that->execution_time, average);
+}
+
 static mtapi_boolean_t embb_mtapi_action_delete_visitor(
   embb_mtapi_task_t * task,
   void * user_data) {
@@ -76,8 +102,7 @@ static mtapi_boolean_t embb_mtapi_action_delete_visitor(
     task->action.id == action->handle.id &&
     task->action.tag == action->handle.tag) {
     /* task is scheduled and needs to be cancelled */
-    embb_mtapi_task_set_state(task, MTAPI_TASK_CANCELLED);
-    task->error_code = MTAPI_ERR_ACTION_DELETED;
+    embb_mtapi_task_try_cancel(task, MTAPI_ERR_ACTION_DELETED);
     result = MTAPI_TRUE;
   }
 
@@ -97,8 +122,7 @@ static mtapi_boolean_t embb_mtapi_action_disable_visitor(
     task->action.id == action->handle.id &&
     task->action.tag == action->handle.tag) {
     /* task is scheduled and needs to be cancelled */
-    embb_mtapi_task_set_state(task, MTAPI_TASK_CANCELLED);
-    task->error_code = MTAPI_ERR_ACTION_DISABLED;
+    embb_mtapi_task_try_cancel(task, MTAPI_ERR_ACTION_DISABLED);
     result = MTAPI_TRUE;
   }
 
@@ -135,7 +159,9 @@ mtapi_action_hndl_t mtapi_action_create(
         new_action->node_local_data = node_local_data;
         new_action->node_local_data_size = node_local_data_size;
         new_action->enabled = MTAPI_TRUE;
+        new_action->deleted = MTAPI_FALSE;
         embb_atomic_store_int(&new_action->num_tasks, 0);
+        embb_atomic_store_unsigned_long_long(&new_action->execution_time, 0);
 
         /* set defaults if no attributes were given */
         if (MTAPI_NULL != attributes) {
@@ -147,7 +173,7 @@ mtapi_action_hndl_t mtapi_action_create(
         }
 
         /* check if affinity is sane */
-        if (0 == new_action->attributes.affinity) {
+        if (embb_bitset_is_empty(new_action->attributes.affinity.rep)) {
           local_status = MTAPI_ERR_PARAMETER;
         }
 
@@ -289,7 +315,9 @@ void mtapi_action_delete(
         embb_time_in(&end_time, &wait_duration);
       }
 
-      /* cancel all tasks */
+      /* cancel all tasks, the ones in the deques of the workers are
+         cancelled when they are taken */
+      local_action->deleted = MTAPI_TRUE;
       embb_mtapi_scheduler_process_tasks(
         node->scheduler, embb_mtapi_action_delete_visitor, local_action);
 
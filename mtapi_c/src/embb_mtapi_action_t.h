@@ -56,8 +56,12 @@ struct embb_mtapi_action_struct {
   mtapi_size_t node_local_data_size;
   mtapi_action_attributes_t attributes;
   mtapi_boolean_t enabled;
+  /* set once mtapi_action_delete has been called */
+  mtapi_boolean_t deleted;
 
   embb_atomic_int num_tasks;
+  /* moving average of the execution time in nanoseconds, 0 if unknown */
+  embb_atomic_unsigned_long_long execution_time;
 };
 
 /**
@@ -78,6 +82,15 @@ void embb_mtapi_action_initialize(embb_mtapi_action_t* that);
  */
 void embb_mtapi_action_finalize(embb_mtapi_action_t* that);
 
+/**
+ * Adds a measured execution time in nanoseconds to the moving average
+ * used for load balancing between the actions of a job.
+ * \memberof embb_mtapi_action_struct
+ */
+void embb_mtapi_action_add_execution_time(
+  embb_mtapi_action_t* that,
+  unsigned long long nanoseconds);
+
 
 /* ---- POOL DECLARATION --------------------------------------------------- */
 
@@ -47,6 +47,24 @@ void embb_mtapi_alloc_deallocate(void * ptr) {
   }
 }
 
+void * embb_mtapi_alloc_allocate_cache_aligned(unsigned int bytes) {
+  void * ptr;
+  bytes = (bytes + EMBB_CACHE_LINE_SIZE - 1) &
+    ~(unsigned int)(EMBB_CACHE_LINE_SIZE - 1);
+  ptr = embb_alloc_cache_aligned(bytes);
+  if (ptr != NULL) {
+    embb_atomic_fetch_and_add_unsigned_int(
+      &embb_mtapi_alloc_bytes_allocated, EMBB_CACHE_LINE_SIZE+bytes);
+  }
+  return ptr;
+}
+
+void embb_mtapi_alloc_deallocate_cache_aligned(void * ptr) {
+  if (ptr != NULL) {
+    embb_free_aligned(ptr);
+  }
+}
+
 void embb_mtapi_alloc_reset_bytes_allocated() {
   embb_atomic_store_unsigned_int(&embb_mtapi_alloc_bytes_allocated, 0);
 }
@@ -34,6 +34,11 @@ extern "C" {
 
 void * embb_mtapi_alloc_allocate(unsigned int bytes);
 void embb_mtapi_alloc_deallocate(void * ptr);
+/* for data written by different threads, the memory starts on a cache line
+   and is padded to whole cache lines, so it never shares a line with other
+   allocations */
+void * embb_mtapi_alloc_allocate_cache_aligned(unsigned int bytes);
+void embb_mtapi_alloc_deallocate_cache_aligned(void * ptr);
 void embb_mtapi_alloc_reset_bytes_allocated();
 unsigned int embb_mtapi_alloc_get_bytes_allocated();
 
@@ -43,6 +43,7 @@ mtapi_status_t embb_mtapi_attr_get_##TYPE(const TYPE* source, \
 embb_mtapi_attr(mtapi_uint_t)
 embb_mtapi_attr(mtapi_affinity_t)
 embb_mtapi_attr(mtapi_boolean_t)
+embb_mtapi_attr(mtapi_timeout_t)
 
 
 #ifdef __cplusplus
@@ -58,6 +58,8 @@ void embb_mtapi_group_initialize(embb_mtapi_group_t * that) {
   that->deleted = MTAPI_FALSE;
   that->num_tasks.internal_variable = 0;
   embb_mtapi_task_queue_initialize(&that->queue);
+  embb_atomic_store_int(&that->pending_tasks, 0);
+  embb_atomic_store_int(&that->continuations, 0);
 }
 
 void embb_mtapi_group_initialize_with_node(
@@ -71,6 +73,8 @@ void embb_mtapi_group_initialize_with_node(
   that->num_tasks.internal_variable = 0;
   embb_mtapi_task_queue_initialize_with_capacity(
     &that->queue, node->attributes.queue_limit);
+  embb_atomic_store_int(&that->pending_tasks, 0);
+  embb_atomic_store_int(&that->continuations, 0);
 }
 
 void embb_mtapi_group_finalize(embb_mtapi_group_t * that) {
@@ -81,6 +85,45 @@ void embb_mtapi_group_finalize(embb_mtapi_group_t * that) {
   embb_mtapi_task_queue_finalize(&that->queue);
 }
 
+void embb_mtapi_group_task_started(
+  embb_mtapi_group_t * that,
+  int count) {
+  assert(MTAPI_NULL != that);
+  embb_atomic_fetch_and_add_int(&that->num_tasks, count);
+  embb_atomic_fetch_and_add_int(&that->pending_tasks, count);
+}
+
+void embb_mtapi_group_task_finished(
+  embb_mtapi_group_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_task_t * task) {
+  int continuations = 0;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != task);
+
+  /* the group may be deleted as soon as the task is handed over, so the
+     continuations are taken first */
+  if (1 == embb_atomic_fetch_and_add_int(&that->pending_tasks, -1)) {
+    continuations = embb_atomic_swap_int(&that->continuations, 0);
+  }
+  embb_mtapi_task_queue_push(&that->queue, task);
+  embb_mtapi_task_start_continuations(node, continuations);
+}
+
+void embb_mtapi_group_check_continuations(
+  embb_mtapi_group_t * that,
+  embb_mtapi_node_t * node) {
+  assert(MTAPI_NULL != that);
+
+  /* the last task may have finished before the continuation was added,
+     whoever takes the list starts it */
+  if (0 == embb_atomic_load_int(&that->pending_tasks)) {
+    embb_mtapi_task_start_continuations(
+      node, embb_atomic_swap_int(&that->continuations, 0));
+  }
+}
+
 
 /* ---- INTERFACE FUNCTIONS ------------------------------------------------ */
 
@@ -388,3 +431,52 @@ void mtapi_group_delete(
 
   mtapi_status_set(status, local_status);
 }
+
+mtapi_task_hndl_t mtapi_group_continue_with(
+  MTAPI_IN mtapi_group_hndl_t predecessor_group,
+  MTAPI_IN mtapi_task_id_t task_id,
+  MTAPI_IN mtapi_job_hndl_t job,
+  MTAPI_IN void* arguments,
+  MTAPI_IN mtapi_size_t arguments_size,
+  MTAPI_OUT void* result_buffer,
+  MTAPI_IN mtapi_size_t result_size,
+  MTAPI_IN mtapi_task_attributes_t* attributes,
+  MTAPI_IN mtapi_group_hndl_t group,
+  MTAPI_OUT mtapi_status_t* status) {
+  mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_hndl_t task_hndl = { 0, EMBB_MTAPI_IDPOOL_INVALID_ID };
+
+  embb_mtapi_log_trace("mtapi_group_continue_with() called\n");
+
+  if (embb_mtapi_node_is_initialized()) {
+    embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+    if (embb_mtapi_group_pool_is_handle_valid(
+      node->group_pool, predecessor_group)) {
+      embb_mtapi_group_t* local_group =
+        embb_mtapi_group_pool_get_storage_for_handle(
+          node->group_pool, predecessor_group);
+      task_hndl = embb_mtapi_task_start_continuation(
+        &local_group->continuations,
+        task_id,
+        job,
+        arguments,
+        arguments_size,
+        result_buffer,
+        result_size,
+        attributes,
+        group,
+        &local_status);
+      if (MTAPI_SUCCESS == local_status) {
+        embb_mtapi_group_check_continuations(local_group, node);
+      }
+    } else {
+      local_status = MTAPI_ERR_GROUP_INVALID;
+    }
+  } else {
+    embb_mtapi_log_error("mtapi not initialized\n");
+    local_status = MTAPI_ERR_NODE_NOTINIT;
+  }
+
+  mtapi_status_set(status, local_status);
+  return task_hndl;
+}
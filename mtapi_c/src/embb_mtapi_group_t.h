@@ -41,6 +41,7 @@ extern "C" {
 /* ---- FORWARD DECLARATIONS ----------------------------------------------- */
 
 typedef struct embb_mtapi_node_struct embb_mtapi_node_t;
+typedef struct embb_mtapi_task_struct embb_mtapi_task_t;
 
 
 /* ---- CLASS DECLARATION -------------------------------------------------- */
@@ -59,6 +60,11 @@ struct embb_mtapi_group_struct {
   embb_atomic_int num_tasks;
   mtapi_group_attributes_t attributes;
   embb_mtapi_task_queue_t queue;
+
+  /* tasks started in the group that have not finished yet */
+  embb_atomic_int pending_tasks;
+  /* id of the first task to start once no task is pending */
+  embb_atomic_int continuations;
 };
 
 /**
@@ -87,6 +93,34 @@ void embb_mtapi_group_initialize_with_node(
  */
 void embb_mtapi_group_finalize(embb_mtapi_group_t * that);
 
+/**
+ * Notify group that an associated task was started.
+ * \memberof embb_mtapi_group_struct
+ */
+void embb_mtapi_group_task_started(
+  embb_mtapi_group_t * that,
+  int count);
+
+/**
+ * Notify group that an associated task has finished. The task is handed to
+ * waiting threads and the continuations of the group are started if it was
+ * the last one pending.
+ * \memberof embb_mtapi_group_struct
+ */
+void embb_mtapi_group_task_finished(
+  embb_mtapi_group_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_task_t * task);
+
+/**
+ * Starts the continuations of the group if no task is pending, used after
+ * a continuation was added.
+ * \memberof embb_mtapi_group_struct
+ */
+void embb_mtapi_group_check_continuations(
+  embb_mtapi_group_t * that,
+  embb_mtapi_node_t * node);
+
 
 /* ---- POOL DECLARATION --------------------------------------------------- */
 
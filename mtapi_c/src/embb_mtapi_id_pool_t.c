@@ -26,6 +26,8 @@
 
 #include <assert.h>
 
+#include <embb/base/c/thread.h>
+
 #include <embb_mtapi_alloc.h>
 #include <embb_mtapi_log.h>
 #include <embb_mtapi_id_pool_t.h>
@@ -34,82 +36,133 @@ void embb_mtapi_id_pool_initialize(
   embb_mtapi_id_pool_t * that,
   mtapi_uint_t capacity) {
   mtapi_uint_t ii;
+  mtapi_uint_t size = 1;
+
+  /* the ring needs a power of 2 size, so positions may wrap around */
+  while (size < capacity) {
+    size <<= 1;
+  }
 
   that->capacity = capacity;
-  that->id_buffer = (mtapi_uint_t*)
-    embb_mtapi_alloc_allocate(sizeof(mtapi_uint_t)*(capacity));
-  that->id_buffer[0] = EMBB_MTAPI_IDPOOL_INVALID_ID;
-  for (ii = 1; ii < capacity; ii++) {
-    that->id_buffer[ii] = ii;
+  that->mask = size - 1;
+  that->slots = (embb_mtapi_id_pool_slot_t*)
+    embb_mtapi_alloc_allocate(sizeof(embb_mtapi_id_pool_slot_t)*size);
+
+  /* nothing was released yet */
+  for (ii = 0; ii < size; ii++) {
+    that->slots[ii].id = EMBB_MTAPI_IDPOOL_INVALID_ID;
+    embb_atomic_store_unsigned_int(&that->slots[ii].sequence, ii);
   }
-  that->ids_availabe = capacity - 1;
-  that->put_id_position = 0;
-  that->get_id_position = 1;
-  embb_mtapi_spinlock_initialize(&that->lock);
+  embb_atomic_store_unsigned_int(&that->get_id_position, 0);
+  embb_atomic_store_unsigned_int(&that->put_id_position, 0);
+  /* id 0 is invalid */
+  embb_atomic_store_unsigned_int(&that->unused_id, 1);
 }
 
 void embb_mtapi_id_pool_finalize(embb_mtapi_id_pool_t * that) {
   that->capacity = 0;
-  that->ids_availabe = 0;
-  that->get_id_position = 0;
-  that->put_id_position = 0;
-  embb_mtapi_alloc_deallocate(that->id_buffer);
-  that->id_buffer = NULL;
-  embb_mtapi_spinlock_finalize(&that->lock);
+  that->mask = 0;
+  embb_atomic_store_unsigned_int(&that->get_id_position, 0);
+  embb_atomic_store_unsigned_int(&that->put_id_position, 0);
+  embb_atomic_store_unsigned_int(&that->unused_id, 0);
+  embb_mtapi_alloc_deallocate(that->slots);
+  that->slots = NULL;
+}
+
+static mtapi_uint_t embb_mtapi_id_pool_allocate_unused(
+  embb_mtapi_id_pool_t * that) {
+  unsigned int id = embb_atomic_load_unsigned_int(&that->unused_id);
+  while (id < that->capacity) {
+    if (embb_atomic_compare_and_swap_unsigned_int(
+      &that->unused_id, &id, id + 1)) {
+      return id;
+    }
+  }
+  return EMBB_MTAPI_IDPOOL_INVALID_ID;
 }
 
 mtapi_uint_t embb_mtapi_id_pool_allocate(embb_mtapi_id_pool_t * that) {
   mtapi_uint_t id = EMBB_MTAPI_IDPOOL_INVALID_ID;
+  embb_mtapi_id_pool_slot_t * slot;
+  unsigned int position;
+  unsigned int sequence;
+  int difference;
 
   assert(MTAPI_NULL != that);
 
-  if (embb_mtapi_spinlock_acquire(&that->lock)) {
-    if (0 < that->ids_availabe) {
-      /* take away one id */
-      that->ids_availabe--;
-
-      /* acquire position to fetch id from */
-      mtapi_uint_t id_position = that->get_id_position;
-      that->get_id_position++;
-      if (that->capacity <= that->get_id_position) {
-        that->get_id_position = 0;
+  position = embb_atomic_load_unsigned_int(&that->get_id_position);
+  for (;;) {
+    slot = &that->slots[position & that->mask];
+    sequence = embb_atomic_load_unsigned_int(&slot->sequence);
+    difference = (int)(sequence - (position + 1));
+    if (0 == difference) {
+      /* slot holds an id, try to claim it */
+      if (embb_atomic_compare_and_swap_unsigned_int(
+        &that->get_id_position, &position, position + 1)) {
+        break;
       }
-
-      /* fetch id */
-      id = that->id_buffer[id_position];
-
-      /* make id entry invalid just in case */
-      that->id_buffer[id_position] = EMBB_MTAPI_IDPOOL_INVALID_ID;
+      /* position was updated by the failed compare and swap */
+    } else if (0 > difference) {
+      if (position ==
+        embb_atomic_load_unsigned_int(&that->put_id_position)) {
+        /* no released id left, use one that was never used */
+        return embb_mtapi_id_pool_allocate_unused(that);
+      }
+      /* an id is being put back into this slot, wait for it */
+      embb_thread_yield();
+      position = embb_atomic_load_unsigned_int(&that->get_id_position);
+    } else {
+      /* another thread was faster, retry at the current position */
+      position = embb_atomic_load_unsigned_int(&that->get_id_position);
     }
-    embb_mtapi_spinlock_release(&that->lock);
   }
 
+  /* fetch id and hand the slot over to deallocate */
+  id = slot->id;
+  slot->id = EMBB_MTAPI_IDPOOL_INVALID_ID;
+  embb_atomic_store_unsigned_int(&slot->sequence, position + that->mask + 1);
+
   return id;
 }
 
 void embb_mtapi_id_pool_deallocate(
   embb_mtapi_id_pool_t * that,
   mtapi_uint_t id) {
+  embb_mtapi_id_pool_slot_t * slot;
+  unsigned int position;
+  unsigned int sequence;
+  int difference;
+
   assert(MTAPI_NULL != that);
 
-  if (embb_mtapi_spinlock_acquire(&that->lock)) {
-    if (that->capacity > that->ids_availabe) {
-      /* acquire position to put id to */
-      mtapi_uint_t id_position = that->put_id_position;
-      that->put_id_position++;
-      if (that->capacity <= that->put_id_position) {
-        that->put_id_position = 0;
+  position = embb_atomic_load_unsigned_int(&that->put_id_position);
+  for (;;) {
+    slot = &that->slots[position & that->mask];
+    sequence = embb_atomic_load_unsigned_int(&slot->sequence);
+    difference = (int)(sequence - position);
+    if (0 == difference) {
+      /* slot is free, try to claim it */
+      if (embb_atomic_compare_and_swap_unsigned_int(
+        &that->put_id_position, &position, position + 1)) {
+        break;
       }
-
-      /* put id back into buffer */
-      that->id_buffer[id_position] = id;
-
-      /* make it available */
-      that->ids_availabe++;
+    } else if (0 > difference) {
+      if (embb_atomic_load_unsigned_int(&that->unused_id) <= position + 1 -
+        embb_atomic_load_unsigned_int(&that->get_id_position)) {
+        /* all ids are released already, id was never allocated */
+        embb_mtapi_log_error(
+          "id pool is full in embb_mtapi_id_pool_deallocate\n");
+        return;
+      }
+      /* the id in this slot is still being fetched, wait for it */
+      embb_thread_yield();
+      position = embb_atomic_load_unsigned_int(&that->put_id_position);
+    } else {
+      position = embb_atomic_load_unsigned_int(&that->put_id_position);
     }
-    embb_mtapi_spinlock_release(&that->lock);
-  } else {
-    embb_mtapi_log_error(
-      "could not acquire lock in embb_mtapi_IdPool_deallocate\n");
   }
+
+  /* put id back and make it available to allocate */
+  slot->id = id;
+  embb_atomic_store_unsigned_int(&slot->sequence, position + 1);
 }
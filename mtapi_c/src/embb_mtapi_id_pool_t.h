@@ -30,8 +30,6 @@
 #include <embb/mtapi/c/mtapi.h>
 #include <embb/base/c/atomic.h>
 
-#include <embb_mtapi_spinlock_t.h>
-
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -39,19 +37,43 @@ extern "C" {
 
 /* ---- CLASS DECLARATION -------------------------------------------------- */
 
+/**
+ * \internal
+ * Slot of the IdPool ring buffer. The sequence number tells whether the slot
+ * holds an id that may be fetched or is free to put an id into.
+ *
+ * \ingroup INTERNAL
+ */
+struct embb_mtapi_id_pool_slot_struct {
+  embb_atomic_unsigned_int sequence;
+  mtapi_uint_t id;
+};
+
+/**
+ * IdPool slot type.
+ * \memberof embb_mtapi_id_pool_slot_struct
+ */
+typedef struct embb_mtapi_id_pool_slot_struct embb_mtapi_id_pool_slot_t;
+
 /**
  * \internal
  * IdPool class.
  *
+ * Released ids are kept in a lock-free bounded ring buffer, so allocation
+ * and deallocation from different threads do not serialize on a lock.
+ * Released ids are handed out in FIFO order to delay their reuse. Ids that
+ * were never used are only handed out if no released id is left, which
+ * keeps the ids in use small and dense.
+ *
  * \ingroup INTERNAL
  */
 struct embb_mtapi_id_pool_struct {
   mtapi_uint_t capacity;
-  mtapi_uint_t *id_buffer;
-  mtapi_uint_t ids_availabe;
-  mtapi_uint_t get_id_position;
-  mtapi_uint_t put_id_position;
-  embb_mtapi_spinlock_t lock;
+  mtapi_uint_t mask;
+  embb_mtapi_id_pool_slot_t *slots;
+  embb_atomic_unsigned_int get_id_position;
+  embb_atomic_unsigned_int put_id_position;
+  embb_atomic_unsigned_int unused_id;
 };
 
 /**
@@ -78,6 +100,7 @@ void embb_mtapi_id_pool_finalize(embb_mtapi_id_pool_t * that);
 
 /**
  * Allocates a single item and removes its id from the pool.
+ * Returns EMBB_MTAPI_IDPOOL_INVALID_ID if no id is left.
  * \memberof embb_mtapi_id_pool_struct
  */
 mtapi_uint_t embb_mtapi_id_pool_allocate(embb_mtapi_id_pool_t * that);
@@ -34,6 +34,8 @@
 #include <mtapi_status_t.h>
 #include <embb_mtapi_action_t.h>
 #include <embb_mtapi_node_t.h>
+#include <embb_mtapi_scheduler_t.h>
+#include <embb/base/c/internal/bitset.h>
 
 
 /* ---- POOL STORAGE FUNCTIONS --------------------------------------------- */
@@ -171,6 +173,75 @@ void embb_mtapi_job_remove_action(
   that->num_actions--;
 }
 
+mtapi_action_hndl_t embb_mtapi_job_select_action(
+  embb_mtapi_job_t * that,
+  embb_mtapi_node_t * node) {
+  mtapi_action_hndl_t result = { 0, EMBB_MTAPI_IDPOOL_INVALID_ID };
+  mtapi_action_hndl_t fallback = { 0, EMBB_MTAPI_IDPOOL_INVALID_ID };
+  unsigned long long best_cost = 0;
+  unsigned long long best_workers = 1;
+  mtapi_uint_t ii;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+
+  /* nothing to balance */
+  if (1 >= that->num_actions) {
+    return that->actions[0];
+  }
+
+  for (ii = 0; ii < that->num_actions; ii++) {
+    embb_mtapi_action_t * action;
+    mtapi_affinity_t affinity;
+    unsigned long long cost;
+    unsigned long long workers;
+
+    if (!embb_mtapi_action_pool_is_handle_valid(
+      node->action_pool, that->actions[ii])) {
+      continue;
+    }
+    action = embb_mtapi_action_pool_get_storage_for_handle(
+      node->action_pool, that->actions[ii]);
+    if (EMBB_MTAPI_IDPOOL_INVALID_ID == fallback.id) {
+      fallback = that->actions[ii];
+    }
+    if (!action->enabled) {
+      continue;
+    }
+
+    /* number of workers the action may run on */
+    affinity = action->attributes.affinity;
+    embb_bitset_intersect(affinity.rep, node->affinity_all.rep);
+    if (embb_bitset_is_empty(affinity.rep) ||
+      embb_bitset_is_equal(affinity.rep, node->affinity_all.rep)) {
+      workers = node->scheduler->worker_count;
+    } else {
+      workers = embb_bitset_count(affinity.rep);
+    }
+
+    /* time until a new task would be done, actions that have not been
+       measured yet look cheap so that they get measured soon */
+    cost = (unsigned long long)
+      (embb_atomic_load_int(&action->num_tasks) + 1) *
+      (embb_atomic_load_unsigned_long_long(&action->execution_time) + 1);
+
+    /* compare cost / workers without dividing */
+    if (EMBB_MTAPI_IDPOOL_INVALID_ID == result.id ||
+      cost * best_workers < best_cost * workers) {
+      result = that->actions[ii];
+      best_cost = cost;
+      best_workers = workers;
+    }
+  }
+
+  /* all actions disabled, behave as if there was only one */
+  if (EMBB_MTAPI_IDPOOL_INVALID_ID == result.id) {
+    result = fallback;
+  }
+
+  return result;
+}
+
 
 /* ---- INTERFACE FUNCTIONS ------------------------------------------------ */
 
@@ -149,6 +149,20 @@ void embb_mtapi_job_remove_action(
   embb_mtapi_job_t * that,
   embb_mtapi_action_t * action);
 
+/**
+ * Select the action a new task of the job is run with.
+ *
+ * Chooses the enabled action with the smallest expected completion time,
+ * estimated from the number of tasks in flight for the action, its measured
+ * execution time and the number of workers its affinity allows. Returns an
+ * invalid handle if the job has no usable action.
+ *
+ * \memberof embb_mtapi_job_struct
+ */
+mtapi_action_hndl_t embb_mtapi_job_select_action(
+  embb_mtapi_job_t * that,
+  embb_mtapi_node_t * node);
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,11 +37,11 @@
 #include <embb_mtapi_task_t.h>
 #include <embb_mtapi_queue_t.h>
 #include <embb_mtapi_scheduler_t.h>
+#include <embb_mtapi_spinlock_t.h>
 #include <embb_mtapi_attr.h>
 
 
 static embb_mtapi_node_t* embb_mtapi_node_instance = NULL;
-extern embb_atomic_int embb_mtapi_spinlock_spins;
 
 /* ---- CLASS MEMBERS ------------------------------------------------------ */
 
@@ -87,7 +87,7 @@ void mtapi_initialize(
       /* out of memory! */
       local_status = MTAPI_ERR_UNKNOWN;
     } else {
-      embb_atomic_store_int(&embb_mtapi_spinlock_spins, 0);
+      embb_mtapi_spinlock_reset_spins();
 
       node = embb_mtapi_node_instance;
 
@@ -179,8 +179,8 @@ void mtapi_finalize(MTAPI_OUT mtapi_status_t* status) {
     embb_mtapi_alloc_deallocate(node);
     embb_mtapi_node_instance = MTAPI_NULL;
 
-    embb_mtapi_log_info("mtapi spinlock spun %d times.\n",
-      embb_atomic_load_int(&embb_mtapi_spinlock_spins));
+    embb_mtapi_log_info("mtapi spinlock spun %lu times.\n",
+      embb_mtapi_spinlock_get_spins());
 
     local_status = MTAPI_SUCCESS;
   } else {
@@ -266,6 +266,34 @@ void mtapi_node_get_attribute(
             &local_node->attributes.max_priorities, attribute, attribute_size);
           break;
 
+        case MTAPI_NODE_SCHEDULER_MODE:
+          local_status = embb_mtapi_attr_get_mtapi_uint_t(
+            &local_node->attributes.scheduler_mode, attribute, attribute_size);
+          break;
+
+        case MTAPI_NODE_IDLE_SPIN_COUNT:
+          local_status = embb_mtapi_attr_get_mtapi_uint_t(
+            &local_node->attributes.idle_spin_count, attribute,
+            attribute_size);
+          break;
+
+        case MTAPI_NODE_IDLE_SPIN_PAUSE:
+          local_status = embb_mtapi_attr_get_mtapi_boolean_t(
+            &local_node->attributes.idle_spin_pause, attribute,
+            attribute_size);
+          break;
+
+        case MTAPI_NODE_IDLE_PARK_TIMEOUT:
+          local_status = embb_mtapi_attr_get_mtapi_timeout_t(
+            &local_node->attributes.idle_park_timeout, attribute,
+            attribute_size);
+          break;
+
+        case MTAPI_NODE_IDLE_ADAPTIVE:
+          local_status = embb_mtapi_attr_get_mtapi_boolean_t(
+            &local_node->attributes.idle_adaptive, attribute, attribute_size);
+          break;
+
         default:
           local_status = MTAPI_ERR_ATTR_NUM;
           break;
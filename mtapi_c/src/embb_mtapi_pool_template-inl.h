@@ -29,6 +29,7 @@
 
 #include <assert.h>
 #include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/atomic.h>
 
 #include <embb_mtapi_alloc.h>
 #include <embb_mtapi_pool_template.h>
@@ -53,35 +54,85 @@ void embb_mtapi_##TYPE##_pool_delete(embb_mtapi_##TYPE##_pool_t * that) { \
   embb_mtapi_alloc_deallocate(that); \
 } \
 \
+/* allocates the given chunk if that did not happen yet */ \
+static embb_mtapi_##TYPE##_t * embb_mtapi_##TYPE##_pool_get_chunk( \
+  embb_mtapi_##TYPE##_pool_t * that, \
+  mtapi_uint_t chunk_index) { \
+  embb_mtapi_##TYPE##_t * chunk = that->chunks[chunk_index]; \
+  mtapi_uint_t ii; \
+  if (MTAPI_NULL == chunk) { \
+    embb_mtapi_spinlock_acquire(&that->chunk_lock); \
+    chunk = that->chunks[chunk_index]; \
+    if (MTAPI_NULL == chunk) { \
+      chunk = (embb_mtapi_##TYPE##_t*) \
+        embb_mtapi_alloc_allocate_cache_aligned( \
+          sizeof(embb_mtapi_##TYPE##_t)*EMBB_MTAPI_POOL_CHUNK_SIZE); \
+      if (MTAPI_NULL != chunk) { \
+        for (ii = 0; ii < EMBB_MTAPI_POOL_CHUNK_SIZE; ii++) { \
+          chunk[ii].handle.id = EMBB_MTAPI_IDPOOL_INVALID_ID; \
+          chunk[ii].handle.tag = 0; \
+        } \
+        /* publish the chunk only after it is initialized */ \
+        embb_atomic_memory_barrier(); \
+        that->chunks[chunk_index] = chunk; \
+      } \
+    } \
+    embb_mtapi_spinlock_release(&that->chunk_lock); \
+  } \
+  return chunk; \
+} \
+\
 mtapi_boolean_t embb_mtapi_##TYPE##_pool_initialize( \
   embb_mtapi_##TYPE##_pool_t * that, \
   mtapi_uint_t capacity) { \
   mtapi_uint_t ii; \
+  embb_mtapi_##TYPE##_t * chunk; \
   assert(MTAPI_NULL != that); \
   embb_mtapi_id_pool_initialize(&that->id_pool, capacity); \
-  that->storage = (embb_mtapi_##TYPE##_t*)embb_mtapi_alloc_allocate( \
-    sizeof(embb_mtapi_##TYPE##_t)*capacity); \
-  for (ii = 0; ii < capacity; ii++) { \
-    that->storage[ii].handle.id = EMBB_MTAPI_IDPOOL_INVALID_ID; \
-    that->storage[ii].handle.tag = 0; \
+  embb_mtapi_spinlock_initialize(&that->chunk_lock); \
+  that->chunk_count = (capacity + EMBB_MTAPI_POOL_CHUNK_SIZE - 1) >> \
+    EMBB_MTAPI_POOL_CHUNK_SHIFT; \
+  if (0 == that->chunk_count) { \
+    that->chunk_count = 1; \
+  } \
+  that->chunks = (embb_mtapi_##TYPE##_t * volatile *) \
+    embb_mtapi_alloc_allocate( \
+      sizeof(embb_mtapi_##TYPE##_t*)*that->chunk_count); \
+  for (ii = 0; ii < that->chunk_count; ii++) { \
+    that->chunks[ii] = MTAPI_NULL; \
   } \
   /* use entry 0 as invalid */ \
-  embb_mtapi_##TYPE##_initialize(that->storage); \
+  chunk = embb_mtapi_##TYPE##_pool_get_chunk(that, 0); \
+  embb_mtapi_##TYPE##_initialize(chunk); \
   return MTAPI_TRUE; \
 } \
 \
 void embb_mtapi_##TYPE##_pool_finalize(embb_mtapi_##TYPE##_pool_t * that) { \
+  mtapi_uint_t ii; \
   embb_mtapi_id_pool_finalize(&that->id_pool); \
-  embb_mtapi_alloc_deallocate(that->storage); \
-  that->storage = MTAPI_NULL; \
+  for (ii = 0; ii < that->chunk_count; ii++) { \
+    if (MTAPI_NULL != that->chunks[ii]) { \
+      embb_mtapi_alloc_deallocate_cache_aligned(that->chunks[ii]); \
+    } \
+  } \
+  embb_mtapi_alloc_deallocate((void*)that->chunks); \
+  that->chunks = MTAPI_NULL; \
+  that->chunk_count = 0; \
+  embb_mtapi_spinlock_finalize(&that->chunk_lock); \
 } \
 \
 embb_mtapi_##TYPE##_t * embb_mtapi_##TYPE##_pool_allocate( \
   embb_mtapi_##TYPE##_pool_t * that) { \
   mtapi_uint_t pool_id = embb_mtapi_id_pool_allocate(&that->id_pool); \
   if (EMBB_MTAPI_IDPOOL_INVALID_ID != pool_id) { \
-    that->storage[pool_id].handle.id = pool_id; \
-    return &that->storage[pool_id]; \
+    embb_mtapi_##TYPE##_t * chunk = embb_mtapi_##TYPE##_pool_get_chunk( \
+      that, pool_id >> EMBB_MTAPI_POOL_CHUNK_SHIFT); \
+    if (MTAPI_NULL == chunk) { \
+      embb_mtapi_id_pool_deallocate(&that->id_pool, pool_id); \
+      return MTAPI_NULL; \
+    } \
+    chunk[pool_id & EMBB_MTAPI_POOL_CHUNK_MASK].handle.id = pool_id; \
+    return &chunk[pool_id & EMBB_MTAPI_POOL_CHUNK_MASK]; \
   } else { \
     return MTAPI_NULL; \
   } \
@@ -97,13 +148,30 @@ void embb_mtapi_##TYPE##_pool_deallocate( \
   embb_mtapi_id_pool_deallocate(&that->id_pool, pool_id); \
 } \
 \
+embb_mtapi_##TYPE##_t * embb_mtapi_##TYPE##_pool_get_storage_for_id( \
+  embb_mtapi_##TYPE##_pool_t * that, \
+  mtapi_uint_t id) { \
+  embb_mtapi_##TYPE##_t * chunk; \
+  assert(MTAPI_NULL != that); \
+  if (id >= that->id_pool.capacity) { \
+    return MTAPI_NULL; \
+  } \
+  chunk = that->chunks[id >> EMBB_MTAPI_POOL_CHUNK_SHIFT]; \
+  return (MTAPI_NULL != chunk) ? \
+    &chunk[id & EMBB_MTAPI_POOL_CHUNK_MASK] : MTAPI_NULL; \
+} \
+\
 mtapi_boolean_t embb_mtapi_##TYPE##_pool_is_handle_valid( \
   embb_mtapi_##TYPE##_pool_t * that, \
   mtapi_##TYPE##_hndl_t handle) { \
+  embb_mtapi_##TYPE##_t * storage; \
   assert(MTAPI_NULL != that); \
-  return ((0 < handle.id) && \
-    (handle.id < that->id_pool.capacity) && \
-    (that->storage[handle.id].handle.tag == handle.tag)) ? \
+  if (0 == handle.id) { \
+    return MTAPI_FALSE; \
+  } \
+  storage = embb_mtapi_##TYPE##_pool_get_storage_for_id(that, handle.id); \
+  return ((MTAPI_NULL != storage) && \
+    (storage->handle.tag == handle.tag)) ? \
       MTAPI_TRUE : MTAPI_FALSE; \
 } \
 \
@@ -112,7 +180,8 @@ embb_mtapi_##TYPE##_t * embb_mtapi_##TYPE##_pool_get_storage_for_handle( \
   mtapi_##TYPE##_hndl_t handle) { \
   assert(MTAPI_NULL != that); \
   assert(embb_mtapi_##TYPE##_pool_is_handle_valid(that, handle)); \
-  return &that->storage[handle.id]; \
+  return &that->chunks[handle.id >> EMBB_MTAPI_POOL_CHUNK_SHIFT][ \
+    handle.id & EMBB_MTAPI_POOL_CHUNK_MASK]; \
 }
 
 #endif // MTAPI_C_SRC_EMBB_MTAPI_POOL_TEMPLATE_INL_H_
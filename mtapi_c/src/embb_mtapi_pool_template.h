@@ -30,19 +30,29 @@
 #include <embb/mtapi/c/mtapi.h>
 
 #include <embb_mtapi_id_pool_t.h>
+#include <embb_mtapi_spinlock_t.h>
+
+/* number of elements per storage chunk is 2^EMBB_MTAPI_POOL_CHUNK_SHIFT */
+#define EMBB_MTAPI_POOL_CHUNK_SHIFT 6
+#define EMBB_MTAPI_POOL_CHUNK_SIZE (1u << EMBB_MTAPI_POOL_CHUNK_SHIFT)
+#define EMBB_MTAPI_POOL_CHUNK_MASK (EMBB_MTAPI_POOL_CHUNK_SIZE - 1)
 
 #define embb_mtapi_pool(TYPE) \
 \
 /** \internal
-TYPE pool class providing a fixed number of TYPE elements. Used to allocate
-TYPE elements without using dynamic memory.
+TYPE pool class providing up to capacity TYPE elements. The elements are
+stored in chunks that are allocated when the first element of a chunk is
+needed, so large capacities do not cost memory up front. Elements never
+move, the id of an element encodes its chunk and its index in the chunk.
 
 \ingroup INTERNAL
 */ \
 struct embb_mtapi_##TYPE##_pool_struct \
 { \
   embb_mtapi_id_pool_t id_pool; \
-  embb_mtapi_##TYPE##_t * storage; \
+  embb_mtapi_##TYPE##_t * volatile * chunks; \
+  mtapi_uint_t chunk_count; \
+  embb_mtapi_spinlock_t chunk_lock; \
 }; \
 \
 /** TYPE pool type.
@@ -94,6 +104,14 @@ mtapi_boolean_t embb_mtapi_##TYPE##_pool_is_handle_valid(\
   embb_mtapi_##TYPE##_pool_t * that, \
   mtapi_##TYPE##_hndl_t handle); \
 \
+/** Return pointer to storage for given id, or MTAPI_NULL if the element
+was never allocated.
+\memberof embb_mtapi_##TYPE##_pool_struct
+*/ \
+embb_mtapi_##TYPE##_t * embb_mtapi_##TYPE##_pool_get_storage_for_id(\
+  embb_mtapi_##TYPE##_pool_t * that, \
+  mtapi_uint_t id); \
+\
 /** Return pointer to storage for given handle. Handle is expected to be valid,
 so check it beforehand using embb_mtapi_##TYPE##_pool_is_handle_valid().
 \memberof embb_mtapi_##TYPE##_pool_struct
@@ -57,9 +57,13 @@ void embb_mtapi_queue_initialize(embb_mtapi_queue_t* that) {
   mtapi_queueattr_init(&that->attributes, MTAPI_NULL);
   that->queue_id = MTAPI_QUEUE_ID_NONE;
   embb_atomic_store_char(&that->enabled, MTAPI_FALSE);
+  embb_atomic_store_char(&that->deleted, MTAPI_FALSE);
   embb_atomic_store_int(&that->num_tasks, 0);
   that->job_handle.id = 0;
   that->job_handle.tag = 0;
+  embb_mtapi_task_queue_initialize(&that->ordered_tasks);
+  embb_atomic_store_int(&that->ordered_pending, 0);
+  embb_mtapi_task_queue_initialize(&that->retained_tasks);
 }
 
 void embb_mtapi_queue_initialize_with_attributes_and_job(
@@ -72,13 +76,19 @@ void embb_mtapi_queue_initialize_with_attributes_and_job(
   that->attributes = *attributes;
   that->queue_id = MTAPI_QUEUE_ID_NONE;
   embb_atomic_store_char(&that->enabled, MTAPI_TRUE);
+  embb_atomic_store_char(&that->deleted, MTAPI_FALSE);
   embb_atomic_store_int(&that->num_tasks, 0);
   that->job_handle = job;
+  embb_mtapi_task_queue_initialize(&that->ordered_tasks);
+  embb_atomic_store_int(&that->ordered_pending, 0);
+  embb_mtapi_task_queue_initialize(&that->retained_tasks);
 }
 
 void embb_mtapi_queue_finalize(embb_mtapi_queue_t* that) {
   assert(MTAPI_NULL != that);
 
+  embb_mtapi_task_queue_finalize(&that->ordered_tasks);
+  embb_mtapi_task_queue_finalize(&that->retained_tasks);
   that->job_handle.id = 0;
   that->job_handle.tag = 0;
   embb_mtapi_queue_initialize(that);
@@ -94,6 +104,99 @@ void embb_mtapi_queue_task_finished(embb_mtapi_queue_t* that) {
   embb_atomic_fetch_and_add_int(&that->num_tasks, -1);
 }
 
+mtapi_boolean_t embb_mtapi_queue_is_ordered(embb_mtapi_queue_t* that) {
+  assert(MTAPI_NULL != that);
+  return (MTAPI_NULL != that->ordered_tasks.task_buffer) ?
+    MTAPI_TRUE : MTAPI_FALSE;
+}
+
+/* takes the first task in line, the pending counter guarantees that there
+   is one, so only a contended lock can make the pop fail */
+static embb_mtapi_task_t* embb_mtapi_queue_ordered_take(
+  embb_mtapi_queue_t* that) {
+  embb_mtapi_task_t* task;
+  do {
+    task = embb_mtapi_task_queue_pop(&that->ordered_tasks);
+  } while (MTAPI_NULL == task);
+  return task;
+}
+
+mtapi_boolean_t embb_mtapi_queue_ordered_push(
+  embb_mtapi_queue_t* that,
+  embb_mtapi_task_t* task,
+  embb_mtapi_task_t** next) {
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != task);
+  assert(MTAPI_NULL != next);
+  assert(embb_mtapi_queue_is_ordered(that));
+
+  *next = MTAPI_NULL;
+  if (!embb_mtapi_task_queue_push(&that->ordered_tasks, task)) {
+    return MTAPI_FALSE;
+  }
+  /* the task is counted after it is in line, so whoever sees it counted
+     will also find it */
+  if (0 == embb_atomic_fetch_and_add_int(&that->ordered_pending, 1)) {
+    /* queue was idle, the token goes to the first task in line */
+    *next = embb_mtapi_queue_ordered_take(that);
+  }
+  return MTAPI_TRUE;
+}
+
+embb_mtapi_task_t* embb_mtapi_queue_ordered_pop(embb_mtapi_queue_t* that) {
+  assert(MTAPI_NULL != that);
+  assert(embb_mtapi_queue_is_ordered(that));
+
+  if (1 < embb_atomic_fetch_and_add_int(&that->ordered_pending, -1)) {
+    return embb_mtapi_queue_ordered_take(that);
+  }
+  return MTAPI_NULL;
+}
+
+embb_mtapi_task_t* embb_mtapi_queue_ordered_drop(embb_mtapi_queue_t* that) {
+  int pending;
+  assert(MTAPI_NULL != that);
+  assert(embb_mtapi_queue_is_ordered(that));
+
+  /* the token holder counts as one, so only a count above that means a
+     task is waiting, discounting it keeps ordered_pop from looking for it */
+  pending = embb_atomic_load_int(&that->ordered_pending);
+  while (1 < pending) {
+    if (embb_atomic_compare_and_swap_int(
+      &that->ordered_pending, &pending, pending - 1)) {
+      return embb_mtapi_queue_ordered_take(that);
+    }
+  }
+  return MTAPI_NULL;
+}
+
+mtapi_boolean_t embb_mtapi_queue_park_task(
+  embb_mtapi_queue_t* that,
+  embb_mtapi_task_t* task) {
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != task);
+
+  if (MTAPI_NULL == that->retained_tasks.task_buffer) {
+    /* queue was not retaining when it was created */
+    return MTAPI_FALSE;
+  }
+  return embb_mtapi_task_queue_push(&that->retained_tasks, task);
+}
+
+embb_mtapi_task_t* embb_mtapi_queue_unpark_task(embb_mtapi_queue_t* that) {
+  embb_mtapi_task_t* task;
+  assert(MTAPI_NULL != that);
+
+  if (MTAPI_NULL == that->retained_tasks.task_buffer) {
+    return MTAPI_NULL;
+  }
+  /* the pop gives up on a contended lock, so retry while tasks are left */
+  do {
+    task = embb_mtapi_task_queue_pop(&that->retained_tasks);
+  } while (MTAPI_NULL == task && 0 < that->retained_tasks.tasks_available);
+  return task;
+}
+
 static mtapi_boolean_t embb_mtapi_queue_delete_visitor(
   embb_mtapi_task_t * task,
   void * user_data) {
@@ -106,8 +209,7 @@ static mtapi_boolean_t embb_mtapi_queue_delete_visitor(
   if (task->queue.id == queue->handle.id &&
       task->queue.tag == queue->handle.tag) {
     /* task is scheduled and needs to be cancelled */
-    embb_mtapi_task_set_state(task, MTAPI_TASK_CANCELLED);
-    task->error_code = MTAPI_ERR_QUEUE_DELETED;
+    embb_mtapi_task_try_cancel(task, MTAPI_ERR_QUEUE_DELETED);
     result = MTAPI_TRUE;
   }
 
@@ -127,11 +229,11 @@ static mtapi_boolean_t embb_mtapi_queue_disable_visitor(
       task->queue.tag == queue->handle.tag) {
     if (queue->attributes.retain) {
       /* task is scheduled and needs to be retained */
-      embb_mtapi_task_set_state(task, MTAPI_TASK_RETAINED);
+      embb_mtapi_task_try_change_state(
+        task, MTAPI_TASK_SCHEDULED, MTAPI_TASK_RETAINED);
     } else {
       /* task is scheduled and needs to be cancelled */
-      embb_mtapi_task_set_state(task, MTAPI_TASK_CANCELLED);
-      task->error_code = MTAPI_ERR_QUEUE_DISABLED;
+      embb_mtapi_task_try_cancel(task, MTAPI_ERR_QUEUE_DISABLED);
     }
     result = MTAPI_TRUE;
   }
@@ -151,7 +253,8 @@ static mtapi_boolean_t embb_mtapi_queue_enable_visitor(
   if (task->queue.id == queue->handle.id &&
       task->queue.tag == queue->handle.tag) {
     /* task is retained and should be scheduled */
-    embb_mtapi_task_set_state(task, MTAPI_TASK_SCHEDULED);
+    embb_mtapi_task_try_change_state(
+      task, MTAPI_TASK_RETAINED, MTAPI_TASK_SCHEDULED);
     result = MTAPI_TRUE;
   }
 
@@ -187,15 +290,16 @@ mtapi_queue_hndl_t mtapi_queue_create(
         if (embb_mtapi_job_is_handle_valid(node, job)) {
           embb_mtapi_queue_initialize_with_attributes_and_job(
             queue, &attr, job);
-          /* for an ordered queue, initialize affinity */
+          /* tasks of an ordered queue are lined up and run one at a
+             time on whichever worker is free */
           if (queue->attributes.ordered) {
-            mtapi_affinity_init(
-              &queue->ordered_affinity,
-              MTAPI_FALSE, MTAPI_NULL);
-            mtapi_affinity_set(
-              &queue->ordered_affinity,
-              queue->handle.id % node->scheduler->worker_count,
-              MTAPI_TRUE, MTAPI_NULL);
+            embb_mtapi_task_queue_initialize_with_capacity(
+              &queue->ordered_tasks, node->attributes.queue_limit);
+          }
+          /* retained tasks are parked until the queue is enabled again */
+          if (queue->attributes.retain) {
+            embb_mtapi_task_queue_initialize_with_capacity(
+              &queue->retained_tasks, node->attributes.queue_limit);
           }
           queue->queue_id = queue_id;
           queue_hndl = queue->handle;
@@ -328,8 +432,10 @@ mtapi_queue_hndl_t mtapi_queue_get(
 
     local_status = MTAPI_ERR_QUEUE_INVALID;
     for (ii = 0; ii < node->attributes.max_queues; ii++) {
-      if (queue_id == node->queue_pool->storage[ii].queue_id) {
-        queue_hndl = node->queue_pool->storage[ii].handle;
+      embb_mtapi_queue_t * queue =
+        embb_mtapi_queue_pool_get_storage_for_id(node->queue_pool, ii);
+      if (MTAPI_NULL != queue && queue_id == queue->queue_id) {
+        queue_hndl = queue->handle;
         local_status = MTAPI_SUCCESS;
         break;
       }
@@ -370,9 +476,28 @@ void mtapi_queue_delete(
       context = embb_mtapi_scheduler_get_current_thread_context(
         node->scheduler);
 
-      /* cancel all tasks */
+      /* cancel all tasks, the ones in the deques of the workers are
+         cancelled when they are taken */
+      embb_atomic_store_char(&local_queue->deleted, MTAPI_TRUE);
       embb_mtapi_scheduler_process_tasks(
         node->scheduler, embb_mtapi_queue_delete_visitor, local_queue);
+      embb_mtapi_task_queue_process(&local_queue->ordered_tasks,
+        embb_mtapi_queue_delete_visitor, local_queue);
+      embb_mtapi_task_queue_process(&local_queue->retained_tasks,
+        embb_mtapi_queue_delete_visitor, local_queue);
+      if (embb_mtapi_queue_is_ordered(local_queue)) {
+        /* tasks waiting for their turn would only be dispatched once the
+           running one is done, which may be after the queue is gone */
+        embb_mtapi_task_t * task;
+        while (MTAPI_NULL !=
+          (task = embb_mtapi_queue_ordered_drop(local_queue))) {
+          embb_mtapi_task_try_cancel(task, MTAPI_ERR_QUEUE_DELETED);
+          embb_mtapi_task_finish(task, node, MTAPI_TASK_CANCELLED);
+          embb_mtapi_queue_task_finished(local_queue);
+        }
+      }
+      /* parked tasks are cancelled now, let the workers finish them */
+      embb_mtapi_scheduler_reschedule_retained(node->scheduler, local_queue);
 
       /* wait for tasks in queue to finish */
       local_status = MTAPI_SUCCESS;
@@ -426,6 +551,8 @@ void mtapi_queue_disable(
       /* cancel or retain all tasks scheduled via queue */
       embb_mtapi_scheduler_process_tasks(
         node->scheduler, embb_mtapi_queue_disable_visitor, local_queue);
+      embb_mtapi_task_queue_process(&local_queue->ordered_tasks,
+        embb_mtapi_queue_disable_visitor, local_queue);
 
       /* if queue is not retaining, wait for all tasks to finish */
       if (MTAPI_FALSE == local_queue->attributes.retain) {
@@ -492,7 +619,11 @@ void mtapi_queue_enable(
         /* reschedule retained tasks */
         embb_mtapi_scheduler_process_tasks(
           node->scheduler, embb_mtapi_queue_enable_visitor, local_queue);
+        embb_mtapi_task_queue_process(&local_queue->ordered_tasks,
+          embb_mtapi_queue_enable_visitor, local_queue);
       }
+      /* and the ones parked while the queue was disabled */
+      embb_mtapi_scheduler_reschedule_retained(node->scheduler, local_queue);
     } else {
       local_status = MTAPI_ERR_QUEUE_INVALID;
     }
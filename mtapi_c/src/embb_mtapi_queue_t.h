@@ -32,6 +32,7 @@
 
 #include <embb_mtapi_pool_template.h>
 #include <embb_mtapi_spinlock_t.h>
+#include <embb_mtapi_task_queue_t.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,7 +41,7 @@ extern "C" {
 
 /* ---- FORWARD DECLARATIONS ----------------------------------------------- */
 
-typedef struct embb_mtapi_task_queue_struct embb_mtapi_task_queue_t;
+typedef struct embb_mtapi_task_struct embb_mtapi_task_t;
 
 
 /* ---- CLASS DECLARATION -------------------------------------------------- */
@@ -56,11 +57,20 @@ struct embb_mtapi_queue_struct {
 
   mtapi_queue_id_t queue_id;
   embb_atomic_char enabled;
+  /* set once mtapi_queue_delete has been called */
+  embb_atomic_char deleted;
   mtapi_job_hndl_t job_handle;
   mtapi_queue_attributes_t attributes;
 
   embb_atomic_int num_tasks;
-  mtapi_affinity_t ordered_affinity;
+
+  /* tasks of an ordered queue wait here for their turn */
+  embb_mtapi_task_queue_t ordered_tasks;
+  /* ordered tasks started but not finished yet, the first of them holds
+     the token that allows it to run */
+  embb_atomic_int ordered_pending;
+  /* retained tasks of a retaining queue wait here while it is disabled */
+  embb_mtapi_task_queue_t retained_tasks;
 };
 
 /**
@@ -102,6 +112,65 @@ void embb_mtapi_queue_task_started(embb_mtapi_queue_t* that);
  */
 void embb_mtapi_queue_task_finished(embb_mtapi_queue_t* that);
 
+/**
+ * Returns MTAPI_TRUE if the tasks of the queue have to run one after
+ * another. This is fixed when the queue is created.
+ * \memberof embb_mtapi_queue_struct
+ */
+mtapi_boolean_t embb_mtapi_queue_is_ordered(embb_mtapi_queue_t* that);
+
+/**
+ * Put a task of an ordered queue in line.
+ *
+ * If no task of the queue is running, \a next is set to the task that
+ * holds the token now and has to be scheduled, otherwise to MTAPI_NULL.
+ * Returns MTAPI_FALSE if there is no room for another task.
+ *
+ * \memberof embb_mtapi_queue_struct
+ */
+mtapi_boolean_t embb_mtapi_queue_ordered_push(
+  embb_mtapi_queue_t* that,
+  embb_mtapi_task_t* task,
+  embb_mtapi_task_t** next);
+
+/**
+ * Pass the token on after the running task of an ordered queue is done.
+ *
+ * Returns the task that has to be scheduled next or MTAPI_NULL if no more
+ * tasks are waiting.
+ *
+ * \memberof embb_mtapi_queue_struct
+ */
+embb_mtapi_task_t* embb_mtapi_queue_ordered_pop(embb_mtapi_queue_t* that);
+
+/**
+ * Take a task of an ordered queue out of line without passing the token.
+ *
+ * Returns a task waiting behind the one holding the token or MTAPI_NULL if
+ * no tasks are waiting. The caller has to finish the task.
+ *
+ * \memberof embb_mtapi_queue_struct
+ */
+embb_mtapi_task_t* embb_mtapi_queue_ordered_drop(embb_mtapi_queue_t* that);
+
+/**
+ * Park a retained task until the queue is enabled again.
+ *
+ * Returns MTAPI_FALSE if the queue cannot hold the task, in that case the
+ * task has to be rescheduled as usual.
+ *
+ * \memberof embb_mtapi_queue_struct
+ */
+mtapi_boolean_t embb_mtapi_queue_park_task(
+  embb_mtapi_queue_t* that,
+  embb_mtapi_task_t* task);
+
+/**
+ * Take a parked task out of the queue, returns MTAPI_NULL if there is none.
+ * \memberof embb_mtapi_queue_struct
+ */
+embb_mtapi_task_t* embb_mtapi_queue_unpark_task(embb_mtapi_queue_t* that);
+
 /* ---- POOL DECLARATION --------------------------------------------------- */
 
 embb_mtapi_pool(queue)
@@ -29,17 +29,20 @@
 #include <embb/base/c/base.h>
 
 #include <embb/base/c/internal/unused.h>
+#include <embb/base/c/internal/bitset.h>
 
 #include <embb_mtapi_scheduler_t.h>
 #include <embb_mtapi_log.h>
 #include <embb_mtapi_node_t.h>
 #include <embb_mtapi_task_queue_t.h>
+#include <embb_mtapi_task_deque_t.h>
 #include <embb_mtapi_thread_context_t.h>
 #include <embb_mtapi_task_context_t.h>
 #include <embb_mtapi_task_t.h>
 #include <embb_mtapi_action_t.h>
 #include <embb_mtapi_alloc.h>
 #include <embb_mtapi_queue_t.h>
+#include <embb_mtapi_spinlock_t.h>
 
 
 /* ---- CLASS MEMBERS ------------------------------------------------------ */
@@ -69,10 +72,122 @@ embb_mtapi_task_t * embb_mtapi_scheduler_get_public_task_from_context(
   assert(MTAPI_NULL != that);
   assert(NULL != thread_context);
 
-  task = embb_mtapi_task_queue_pop(thread_context->queue[priority]);
+  /* own deque first, it holds the most recently spawned tasks */
+  task = embb_mtapi_task_deque_pop_bottom(thread_context->deque[priority]);
+  if (MTAPI_NULL == task) {
+    task = embb_mtapi_task_queue_pop(thread_context->queue[priority]);
+  }
   return task;
 }
 
+embb_mtapi_task_t * embb_mtapi_scheduler_steal_task_from_context(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_thread_context_t * thread_context,
+  mtapi_uint_t priority) {
+  EMBB_UNUSED(that);
+
+  embb_mtapi_task_t * task;
+
+  assert(MTAPI_NULL != that);
+  assert(NULL != thread_context);
+
+  /* oldest tasks of the victim's deque first */
+  task = embb_mtapi_task_deque_steal_top(thread_context->deque[priority]);
+  if (MTAPI_NULL == task) {
+    task = embb_mtapi_task_queue_pop(thread_context->queue[priority]);
+  }
+  return task;
+}
+
+embb_mtapi_task_t * embb_mtapi_scheduler_steal_half_from_context(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_thread_context_t * thread_context,
+  embb_mtapi_thread_context_t * victim_context,
+  mtapi_uint_t priority) {
+  EMBB_UNUSED(that);
+
+  embb_mtapi_task_t * tasks[EMBB_MTAPI_SCHEDULER_STEAL_HALF_MAX];
+  embb_mtapi_task_deque_t * local_deque = thread_context->deque[priority];
+  mtapi_uint_t max_tasks;
+  mtapi_uint_t count;
+  mtapi_uint_t ii;
+
+  assert(MTAPI_NULL != that);
+  assert(NULL != thread_context);
+  assert(NULL != victim_context);
+
+  /* the first task is returned, the others need to fit into the local
+     deque, free slots only grow as long as we do not push ourselves */
+  max_tasks = embb_mtapi_task_deque_get_free_slots(local_deque) + 1;
+  if (max_tasks > EMBB_MTAPI_SCHEDULER_STEAL_HALF_MAX) {
+    max_tasks = EMBB_MTAPI_SCHEDULER_STEAL_HALF_MAX;
+  }
+
+  count = embb_mtapi_task_deque_steal_half(
+    victim_context->deque[priority], tasks, max_tasks);
+  if (0 == count) {
+    count = embb_mtapi_task_queue_pop_half(
+      victim_context->queue[priority], tasks, max_tasks);
+  }
+  if (0 == count) {
+    return MTAPI_NULL;
+  }
+
+  /* keep the rest locally, oldest ones stay on top for other thieves */
+  for (ii = 1; ii < count; ii++) {
+    mtapi_boolean_t pushed =
+      embb_mtapi_task_deque_push_bottom(local_deque, tasks[ii]);
+    assert(MTAPI_TRUE == pushed);
+    EMBB_UNUSED_IN_RELEASE(pushed);
+  }
+
+  return tasks[0];
+}
+
+mtapi_uint_t embb_mtapi_scheduler_get_victim_offset(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_thread_context_t * thread_context) {
+  mtapi_uint_t offset = 0;
+
+  assert(MTAPI_NULL != that);
+  assert(NULL != thread_context);
+
+  if (WORK_STEAL_RANDOM_VHPF == that->mode && 1 < that->worker_count) {
+    /* xorshift32, cheap and good enough to spread out the thieves */
+    mtapi_uint32_t state = thread_context->random_state;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    thread_context->random_state = state;
+    offset = (mtapi_uint_t)(state % (that->worker_count - 1));
+  }
+
+  return offset;
+}
+
+embb_mtapi_thread_context_t * embb_mtapi_scheduler_get_victim(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_thread_context_t * thread_context,
+  mtapi_uint_t offset,
+  mtapi_uint_t attempt) {
+  mtapi_uint_t local_count = thread_context->local_victim_count;
+  mtapi_uint_t index;
+
+  assert(MTAPI_NULL != that);
+  assert(attempt < that->worker_count - 1);
+
+  /* workers of the own NUMA domain are visited before the remote ones,
+     the offset rotates the start within both groups */
+  if (attempt < local_count) {
+    index = (offset + attempt) % local_count;
+  } else {
+    index = local_count + (offset + attempt - local_count) %
+      (that->worker_count - 1 - local_count);
+  }
+
+  return &that->worker_contexts[thread_context->victims[index]];
+}
+
 embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task_vhpf(
   embb_mtapi_scheduler_t * that,
   embb_mtapi_node_t * node,
@@ -97,18 +212,23 @@ embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task_vhpf(
         that, thread_context, ii);
       if (MTAPI_NULL == task) {
         /* still nothing, steal from public queues of other workers.
-           the process starts at the worker "after" the current worker,
-           it might be better to start at a random worker
+           the first victim depends on the scheduler mode, after that
+           all other workers are visited in order, local NUMA domain first
         */
-        mtapi_uint_t context_index =
-          (thread_context->worker_index + 1) % that->worker_count;
+        mtapi_uint_t offset =
+          embb_mtapi_scheduler_get_victim_offset(that, thread_context);
         for (kk = 0;
           kk < that->worker_count - 1 && MTAPI_NULL == task;
           kk++) {
-          task = embb_mtapi_task_queue_pop(
-            that->worker_contexts[context_index].queue[ii]);
-          context_index =
-            (context_index + 1) % that->worker_count;
+          embb_mtapi_thread_context_t * victim =
+            embb_mtapi_scheduler_get_victim(that, thread_context, offset, kk);
+          if (WORK_STEAL_HALF_VHPF == that->mode) {
+            task = embb_mtapi_scheduler_steal_half_from_context(
+              that, thread_context, victim, ii);
+          } else {
+            task = embb_mtapi_scheduler_steal_task_from_context(
+              that, victim, ii);
+          }
         }
       }
     }
@@ -145,21 +265,18 @@ embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task_lf(
   }
 
   /* still nothing, steal from public queues of other workers.
-     the process starts at the worker "after" the current worker,
-     it might be better to start at a random worker
+     the process starts at the worker "after" the current worker within
+     the local NUMA domain, it might be better to start at a random worker
   */
   for (prio = 0;
     MTAPI_NULL == task && prio < node->attributes.max_priorities;
     prio++) {
-    mtapi_uint_t context_index =
-      (thread_context->worker_index + 1) % that->worker_count;
     for (kk = 0;
       kk < that->worker_count - 1 && MTAPI_NULL == task;
       kk++) {
-      task = embb_mtapi_task_queue_pop(
-        that->worker_contexts[context_index].queue[prio]);
-      context_index =
-        (context_index + 1) % that->worker_count;
+      task = embb_mtapi_scheduler_steal_task_from_context(
+        that, embb_mtapi_scheduler_get_victim(that, thread_context, 0, kk),
+        prio);
     }
   }
   return task;
@@ -181,6 +298,8 @@ embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task(
       that, node, thread_context);
     break;
   case WORK_STEAL_VHPF:
+  case WORK_STEAL_RANDOM_VHPF:
+  case WORK_STEAL_HALF_VHPF:
     task = embb_mtapi_scheduler_get_next_task_vhpf(
       that, node, thread_context);
     break;
@@ -195,23 +314,194 @@ embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task(
 
 embb_mtapi_thread_context_t * embb_mtapi_scheduler_get_current_thread_context(
   embb_mtapi_scheduler_t * that) {
-  mtapi_uint_t ii = 0;
-  embb_mtapi_thread_context_t * context = NULL;
+  embb_mtapi_thread_context_t * context;
 
   assert(MTAPI_NULL != that);
 
   /* find out on which thread we are */
-  for (ii = 0; ii < that->worker_count; ii++) {
-    context = (embb_mtapi_thread_context_t*)embb_tss_get(
-      &(that->worker_contexts[ii].tss_id));
-    if (NULL != context) {
-      break;
-    }
+  context = embb_mtapi_thread_context_get_current();
+  if (NULL != context &&
+    (context < that->worker_contexts ||
+     context >= that->worker_contexts + that->worker_count)) {
+    /* worker of another scheduler */
+    context = NULL;
   }
 
   return context;
 }
 
+static mtapi_boolean_t embb_mtapi_scheduler_dispatch_task(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_task_t * task);
+
+static void embb_mtapi_scheduler_dispatch_ordered(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_queue_t * queue,
+  embb_mtapi_task_t * task);
+
+/* tells the queue of a task that the task is done, for an ordered queue
+   the next task in line gets its turn */
+static void embb_mtapi_scheduler_queue_task_finished(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_queue_t * queue) {
+  if (embb_mtapi_queue_is_ordered(queue)) {
+    /* the next task keeps the queue busy, so it is dispatched before the
+       finished one is discounted */
+    embb_mtapi_scheduler_dispatch_ordered(
+      that, queue, embb_mtapi_queue_ordered_pop(queue));
+  }
+  embb_mtapi_queue_task_finished(queue);
+}
+
+/* the task will not run, so it no longer counts for its action */
+static void embb_mtapi_scheduler_release_action(
+  embb_mtapi_node_t * node,
+  embb_mtapi_task_t * task) {
+  if (embb_mtapi_action_pool_is_handle_valid(
+    node->action_pool, task->action)) {
+    embb_mtapi_action_t * local_action =
+      embb_mtapi_action_pool_get_storage_for_handle(
+        node->action_pool, task->action);
+    embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
+  }
+}
+
+/* accounts for a task that was cancelled before it could run */
+static void embb_mtapi_scheduler_drop_task(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_task_t * task,
+  embb_mtapi_queue_t * queue) {
+  embb_mtapi_task_finish(task, node, MTAPI_TASK_CANCELLED);
+  if (MTAPI_NULL != queue) {
+    embb_mtapi_scheduler_queue_task_finished(that, queue);
+  }
+}
+
+/* the deques of the workers are not visited when an action or a queue is
+   disabled or deleted, so a scheduled task is checked when it is taken.
+   returns the state the task has to be handled in. */
+static mtapi_task_state_t embb_mtapi_scheduler_check_task(
+  embb_mtapi_node_t * node,
+  embb_mtapi_task_t * task,
+  embb_mtapi_queue_t * queue) {
+  mtapi_status_t error = MTAPI_SUCCESS;
+
+  if (embb_mtapi_action_pool_is_handle_valid(
+    node->action_pool, task->action)) {
+    embb_mtapi_action_t * local_action =
+      embb_mtapi_action_pool_get_storage_for_handle(
+        node->action_pool, task->action);
+    if (local_action->deleted) {
+      error = MTAPI_ERR_ACTION_DELETED;
+    } else if (!local_action->enabled) {
+      error = MTAPI_ERR_ACTION_DISABLED;
+    }
+  }
+
+  if (MTAPI_SUCCESS == error && MTAPI_NULL != queue) {
+    if (MTAPI_FALSE != embb_atomic_load_char(&queue->deleted)) {
+      error = MTAPI_ERR_QUEUE_DELETED;
+    } else if (MTAPI_FALSE == embb_atomic_load_char(&queue->enabled)) {
+      if (queue->attributes.retain) {
+        embb_mtapi_task_try_change_state(
+          task, MTAPI_TASK_SCHEDULED, MTAPI_TASK_RETAINED);
+        return embb_mtapi_task_get_state(task);
+      }
+      error = MTAPI_ERR_QUEUE_DISABLED;
+    }
+  }
+
+  if (MTAPI_SUCCESS != error) {
+    embb_mtapi_task_try_cancel(task, error);
+    return embb_mtapi_task_get_state(task);
+  }
+  return MTAPI_TASK_SCHEDULED;
+}
+
+/* handles a task fetched from the queues according to its state, returns
+   MTAPI_TRUE if it was executed */
+static mtapi_boolean_t embb_mtapi_scheduler_run_task(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_thread_context_t * thread_context,
+  embb_mtapi_task_t * task) {
+  embb_mtapi_task_context_t task_context;
+  embb_mtapi_queue_t * local_queue = MTAPI_NULL;
+  mtapi_task_state_t state;
+  mtapi_boolean_t result = MTAPI_FALSE;
+
+  /* is task associated with a queue? */
+  if (embb_mtapi_queue_pool_is_handle_valid(
+    node->queue_pool, task->queue)) {
+    local_queue =
+      embb_mtapi_queue_pool_get_storage_for_handle(
+        node->queue_pool, task->queue);
+  }
+
+  state = embb_mtapi_task_get_state(task);
+  if (MTAPI_TASK_SCHEDULED == state) {
+    state = embb_mtapi_scheduler_check_task(node, task, local_queue);
+  }
+  if (1 < task->attributes.num_instances &&
+    MTAPI_TASK_RETAINED != state) {
+    /* every copy of a multi-instance task has to be executed, whatever
+       the state, as the last one completes the task */
+    state = MTAPI_TASK_SCHEDULED;
+  }
+
+  switch (state) {
+  case MTAPI_TASK_SCHEDULED:
+    /* there was work, execute it */
+    embb_mtapi_task_context_initialize_with_thread_context_and_task(
+      &task_context, thread_context, task);
+    /* tell queue that a task is done */
+    if (embb_mtapi_task_execute(task, &task_context) &&
+      MTAPI_NULL != local_queue) {
+      embb_mtapi_scheduler_queue_task_finished(that, local_queue);
+    }
+    result = MTAPI_TRUE;
+    break;
+
+  case MTAPI_TASK_RETAINED:
+    /* task is not done, so do not notify queue. a task of an ordered queue
+       keeps its token. */
+    if (MTAPI_NULL != local_queue &&
+      embb_mtapi_queue_park_task(local_queue, task)) {
+      /* parked until the queue is enabled, which might just have happened
+         without seeing the task */
+      if (MTAPI_TRUE == embb_atomic_load_char(&local_queue->enabled)) {
+        embb_mtapi_scheduler_reschedule_retained(that, local_queue);
+      }
+    } else {
+      /* no room to park, put task into queue again for later execution */
+      embb_mtapi_scheduler_dispatch_task(that, task);
+      /* yield, as there may be only retained tasks in the queue */
+      embb_thread_yield();
+    }
+    break;
+
+  case MTAPI_TASK_CANCELLED:
+    /* tell action, group and queue that a task is done */
+    embb_mtapi_scheduler_drop_task(that, node, task, local_queue);
+    break;
+
+  case MTAPI_TASK_COMPLETED:
+  case MTAPI_TASK_DELETED:
+  case MTAPI_TASK_WAITING:
+  case MTAPI_TASK_RUNNING:
+  case MTAPI_TASK_CREATED:
+  case MTAPI_TASK_PRENATAL:
+  case MTAPI_TASK_ERROR:
+  case MTAPI_TASK_INTENTIONALLY_UNUSED:
+  default:
+    /* do nothing, although this is an error */
+    break;
+  }
+
+  return result;
+}
+
 void embb_mtapi_scheduler_execute_task_or_yield(
   embb_mtapi_scheduler_t * that,
   embb_mtapi_node_t * node,
@@ -224,10 +514,7 @@ void embb_mtapi_scheduler_execute_task_or_yield(
       that, node, thread_context);
     /* if there was work, execute it */
     if (MTAPI_NULL != new_task) {
-      embb_mtapi_task_context_t task_context;
-      embb_mtapi_task_context_initialize_with_thread_context_and_task(
-        &task_context, thread_context, new_task);
-      embb_mtapi_task_execute(new_task, &task_context);
+      embb_mtapi_scheduler_run_task(that, node, thread_context, new_task);
     } else {
       embb_thread_yield();
     }
@@ -236,6 +523,66 @@ void embb_mtapi_scheduler_execute_task_or_yield(
   }
 }
 
+/* puts the worker to sleep until it is woken up or the timeout expires,
+   a timeout of MTAPI_NULL sleeps until woken up. as a task might have been
+   scheduled right before the worker announced that it is going to sleep,
+   it looks for work once more and returns the task instead of sleeping if
+   it finds one. */
+static embb_mtapi_task_t * embb_mtapi_scheduler_sleep(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_thread_context_t * thread_context,
+  embb_duration_t * sleep_duration) {
+  embb_mtapi_task_t * task;
+  int expected = 1;
+
+  embb_mutex_lock(&thread_context->work_available_mutex);
+  embb_atomic_store_int(&thread_context->is_sleeping, 1);
+  embb_atomic_fetch_and_add_int(&that->sleeping_workers, 1);
+
+  task = embb_mtapi_scheduler_get_next_task(that, node, thread_context);
+  if (MTAPI_NULL == task && embb_atomic_load_int(&thread_context->run)) {
+    if (MTAPI_NULL == sleep_duration) {
+      embb_condition_wait(
+        &thread_context->work_available,
+        &thread_context->work_available_mutex);
+    } else {
+      embb_condition_wait_for(
+        &thread_context->work_available,
+        &thread_context->work_available_mutex,
+        sleep_duration);
+    }
+  }
+
+  /* leave sleeping state, unless the waker did already */
+  if (embb_atomic_compare_and_swap_int(
+    &thread_context->is_sleeping, &expected, 0)) {
+    embb_atomic_fetch_and_add_int(&that->sleeping_workers, -1);
+  }
+  embb_mutex_unlock(&thread_context->work_available_mutex);
+
+  return task;
+}
+
+/* wakes up a single sleeping worker, starting the search at the given
+   worker index. does nothing if no worker is sleeping. */
+static void embb_mtapi_scheduler_wakeup_any(
+  embb_mtapi_scheduler_t * that,
+  mtapi_uint_t start_index) {
+  mtapi_uint_t ii;
+
+  for (ii = 0;
+    ii < that->worker_count &&
+    0 < embb_atomic_load_int(&that->sleeping_workers);
+    ii++) {
+    if (embb_mtapi_thread_context_wakeup(
+      &that->worker_contexts[(start_index + ii) % that->worker_count])) {
+      embb_atomic_fetch_and_add_int(&that->sleeping_workers, -1);
+      break;
+    }
+  }
+}
+
 embb_mtapi_scheduler_worker_func_t *
 embb_mtapi_scheduler_worker_func(embb_mtapi_scheduler_t * that) {
   EMBB_UNUSED(that);
@@ -252,11 +599,12 @@ embb_mtapi_scheduler_worker_func(embb_mtapi_scheduler_t * that) {
 int embb_mtapi_scheduler_worker(void * arg) {
   embb_mtapi_thread_context_t * thread_context =
     (embb_mtapi_thread_context_t*)arg;
-  embb_mtapi_task_context_t task_context;
   embb_mtapi_node_t * node;
   embb_duration_t sleep_duration;
-  int err;
-  int counter = 0;
+  embb_duration_t * park_duration = &sleep_duration;
+  mtapi_uint_t counter = 0;
+  mtapi_uint_t spin_limit;
+  mtapi_boolean_t parked = MTAPI_FALSE;
 
   embb_mtapi_log_trace(
     "embb_mtapi_scheduler_worker() called for thread %d on core %d\n",
@@ -264,19 +612,21 @@ int embb_mtapi_scheduler_worker(void * arg) {
 
   assert(MTAPI_NULL != thread_context);
 
-  err = embb_tss_create(&thread_context->tss_id);
-  if (EMBB_SUCCESS != err) {
-    /* report error to scheduler */
-    embb_atomic_store_int(&thread_context->run, -1);
-    return MTAPI_FALSE;
-  }
-
   /* node is initialized here, otherwise the worker would not run */
   node = thread_context->node;
 
-  embb_tss_set(&(thread_context->tss_id), thread_context);
+  embb_mtapi_thread_context_set_current(thread_context);
 
-  embb_duration_set_milliseconds(&sleep_duration, 10);
+  /* the thread is already pinned, so the queues end up on its NUMA node */
+  embb_mtapi_thread_context_initialize_queues(thread_context);
+
+  spin_limit = node->attributes.idle_spin_count;
+  if (0 > node->attributes.idle_park_timeout) {
+    park_duration = MTAPI_NULL;
+  } else {
+    embb_duration_set_milliseconds(&sleep_duration,
+      (unsigned long long)node->attributes.idle_park_timeout);
+  }
 
   /* signal that we're up & running */
   embb_atomic_store_int(&thread_context->run, 1);
@@ -290,81 +640,94 @@ int embb_mtapi_scheduler_worker(void * arg) {
     /* try to get work */
     embb_mtapi_task_t * task = embb_mtapi_scheduler_get_next_task(
       node->scheduler, node, thread_context);
-    /* check if there was work */
-    if (MTAPI_NULL != task) {
-      embb_mtapi_queue_t * local_queue = MTAPI_NULL;
-
-      /* is task associated with a queue? */
-      if (embb_mtapi_queue_pool_is_handle_valid(
-        node->queue_pool, task->queue)) {
-        local_queue =
-          embb_mtapi_queue_pool_get_storage_for_handle(
-            node->queue_pool, task->queue);
-      }
-
-      switch (task->state) {
-      case MTAPI_TASK_SCHEDULED:
-        /* there was work, execute it */
-        embb_mtapi_task_context_initialize_with_thread_context_and_task(
-          &task_context, thread_context, task);
-        embb_mtapi_task_execute(task, &task_context);
-        /* tell queue that a task is done */
-        if (MTAPI_NULL != local_queue) {
-          embb_mtapi_queue_task_finished(local_queue);
+    if (MTAPI_NULL == task) {
+      if (counter < spin_limit) {
+        /* spin for a while before going to sleep */
+        if (node->attributes.idle_spin_pause) {
+          embb_mtapi_spinlock_pause();
+        } else {
+          embb_thread_yield();
         }
-        counter = 0;
-        break;
-
-      case MTAPI_TASK_RETAINED:
-        /* put task into queue again for later execution */
-        embb_mtapi_scheduler_schedule_task(
-          node->scheduler, task);
-        /* yield, as there may be only retained tasks in the queue */
-        embb_thread_yield();
-        /* task is not done, so do not notify queue */
-        break;
-
-      case MTAPI_TASK_CANCELLED:
-        /* set return value to cancelled */
-        task->error_code = MTAPI_ERR_ACTION_CANCELLED;
-        /* tell queue that a task is done */
-        if (MTAPI_NULL != local_queue) {
-          embb_mtapi_queue_task_finished(local_queue);
+        counter++;
+      } else {
+        if (node->attributes.idle_adaptive && !parked && 1 < spin_limit) {
+          /* spinning was in vain, park earlier next time */
+          spin_limit /= 2;
         }
-        break;
-
-      case MTAPI_TASK_COMPLETED:
-      case MTAPI_TASK_DELETED:
-      case MTAPI_TASK_WAITING:
-      case MTAPI_TASK_RUNNING:
-      case MTAPI_TASK_CREATED:
-      case MTAPI_TASK_PRENATAL:
-      case MTAPI_TASK_ERROR:
-      case MTAPI_TASK_INTENTIONALLY_UNUSED:
-      default:
-        /* do nothing, although this is an error */
-        break;
+        parked = MTAPI_TRUE;
+        /* no work, go to sleep */
+        task = embb_mtapi_scheduler_sleep(
+          node->scheduler, node, thread_context, park_duration);
       }
-    } else if (counter < 1024) {
-      /* spin and yield for a while before going to sleep */
-      embb_thread_yield();
-      counter++;
-    } else {
-      /* no work, go to sleep */
-      embb_mutex_lock(&thread_context->work_available_mutex);
-      embb_condition_wait_for(
-        &thread_context->work_available,
-        &thread_context->work_available_mutex,
-        &sleep_duration);
-      embb_mutex_unlock(&thread_context->work_available_mutex);
+    }
+    /* check if there was work */
+    if (MTAPI_NULL != task &&
+      embb_mtapi_scheduler_run_task(
+        node->scheduler, node, thread_context, task)) {
+      if (node->attributes.idle_adaptive && !parked && 0 < counter) {
+        /* work arrived while spinning, spin longer next time */
+        spin_limit *= 2;
+        if (spin_limit > node->attributes.idle_spin_count) {
+          spin_limit = node->attributes.idle_spin_count;
+        }
+      }
+      counter = 0;
+      parked = MTAPI_FALSE;
     }
   }
 
-  embb_tss_delete(&(thread_context->tss_id));
+  embb_mtapi_thread_context_set_current(NULL);
 
   return MTAPI_TRUE;
 }
 
+static mtapi_boolean_t embb_mtapi_scheduler_task_is_pending(
+  embb_mtapi_task_t * task) {
+  /* a task being cancelled is pending until its error code is written,
+     and until it is finished */
+  int state = embb_atomic_load_int(&task->state);
+  return (
+    (MTAPI_TASK_SCHEDULED == state) ||
+    (MTAPI_TASK_RUNNING == state) ||
+    (MTAPI_TASK_RETAINED == state) ||
+    (EMBB_MTAPI_TASK_CANCELLING == state) ||
+    (EMBB_MTAPI_TASK_CANCEL_PENDING == state)) ? MTAPI_TRUE : MTAPI_FALSE;
+}
+
+/* blocks a thread that is not a worker until the task has finished or the
+   given end time has passed, MTAPI_NULL waits forever. the task announces
+   its waiter, so finishing it wakes up the blocked threads. */
+static mtapi_boolean_t embb_mtapi_scheduler_block_for_task(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_task_t * task,
+  embb_time_t * end_time) {
+  mtapi_boolean_t result = MTAPI_TRUE;
+
+  embb_atomic_fetch_and_add_int(&task->num_waiters, 1);
+  embb_mutex_lock(&that->waiter_mutex);
+  while (embb_mtapi_scheduler_task_is_pending(task)) {
+    if (MTAPI_NULL == end_time) {
+      embb_condition_wait(&that->task_finished, &that->waiter_mutex);
+    } else if (EMBB_TIMEDOUT == embb_condition_wait_until(
+      &that->task_finished, &that->waiter_mutex, end_time)) {
+      result = !embb_mtapi_scheduler_task_is_pending(task);
+      break;
+    }
+  }
+  embb_mutex_unlock(&that->waiter_mutex);
+  embb_atomic_fetch_and_add_int(&task->num_waiters, -1);
+
+  return result;
+}
+
+void embb_mtapi_scheduler_notify_waiters(embb_mtapi_scheduler_t * that) {
+  assert(MTAPI_NULL != that);
+
+  embb_mutex_lock(&that->waiter_mutex);
+  embb_condition_notify_all(&that->task_finished);
+  embb_mutex_unlock(&that->waiter_mutex);
+}
+
 mtapi_boolean_t embb_mtapi_scheduler_wait_for_task(
   embb_mtapi_task_t * task,
   mtapi_timeout_t timeout) {
@@ -385,11 +748,14 @@ mtapi_boolean_t embb_mtapi_scheduler_wait_for_task(
   context = embb_mtapi_scheduler_get_current_thread_context(
     node->scheduler);
 
-  /* now wait and schedule new tasks if we are on a worker */
-  while (
-    (MTAPI_TASK_SCHEDULED == task->state) ||
-    (MTAPI_TASK_RUNNING == task->state) ||
-    (MTAPI_TASK_RETAINED == task->state) ) {
+  /* there is nothing to help with outside of the workers, so block */
+  if (MTAPI_NULL == context) {
+    return embb_mtapi_scheduler_block_for_task(node->scheduler, task,
+      (MTAPI_INFINITE < timeout) ? &end_time : MTAPI_NULL);
+  }
+
+  /* now wait and schedule new tasks while we are on a worker */
+  while (embb_mtapi_scheduler_task_is_pending(task)) {
     if (MTAPI_INFINITE < timeout) {
       embb_time_t current_time;
       embb_time_now(&current_time);
@@ -411,7 +777,45 @@ mtapi_boolean_t embb_mtapi_scheduler_wait_for_task(
 
 mtapi_boolean_t embb_mtapi_scheduler_initialize(
   embb_mtapi_scheduler_t * that) {
-  return embb_mtapi_scheduler_initialize_with_mode(that, WORK_STEAL_VHPF);
+  embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+
+  assert(MTAPI_NULL != node);
+
+  return embb_mtapi_scheduler_initialize_with_mode(that,
+    (embb_mtapi_scheduler_mode_t)node->attributes.scheduler_mode);
+}
+
+void embb_mtapi_scheduler_initialize_victims(
+  embb_mtapi_scheduler_t * that) {
+  mtapi_uint_t ii;
+  mtapi_uint_t kk;
+
+  for (ii = 0; ii < that->worker_count; ii++) {
+    embb_mtapi_thread_context_t * context = &that->worker_contexts[ii];
+    mtapi_uint_t local_index = 0;
+    mtapi_uint_t remote_index;
+
+    context->local_victim_count = 0;
+    for (kk = 0; kk < that->worker_count; kk++) {
+      if (kk != ii &&
+        that->worker_contexts[kk].numa_domain == context->numa_domain) {
+        context->local_victim_count++;
+      }
+    }
+
+    /* same domain first, both groups ordered starting after this worker */
+    context->victims = (mtapi_uint_t*)embb_mtapi_alloc_allocate(
+      sizeof(mtapi_uint_t)*that->worker_count);
+    remote_index = context->local_victim_count;
+    for (kk = 1; kk < that->worker_count; kk++) {
+      mtapi_uint_t victim = (ii + kk) % that->worker_count;
+      if (that->worker_contexts[victim].numa_domain == context->numa_domain) {
+        context->victims[local_index++] = victim;
+      } else {
+        context->victims[remote_index++] = victim;
+      }
+    }
+  }
 }
 
 mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
@@ -426,6 +830,9 @@ mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
   assert(MTAPI_NULL != node);
 
   embb_atomic_store_int(&that->affine_task_counter, 0);
+  embb_atomic_store_int(&that->sleeping_workers, 0);
+  embb_mutex_init(&that->waiter_mutex, EMBB_MUTEX_PLAIN);
+  embb_condition_init(&that->task_finished);
 
   /* Paranoia sanitizing of scheduler mode */
   if (mode < 0 || mode >= NUM_SCHEDULER_MODES) {
@@ -438,7 +845,7 @@ mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
   that->worker_count = node->attributes.num_cores;
 
   that->worker_contexts = (embb_mtapi_thread_context_t*)
-    embb_mtapi_alloc_allocate(
+    embb_mtapi_alloc_allocate_cache_aligned(
       sizeof(embb_mtapi_thread_context_t)*that->worker_count);
   for (ii = 0; ii < that->worker_count; ii++) {
     unsigned int core_num = 0;
@@ -454,6 +861,7 @@ mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
     embb_mtapi_thread_context_initialize_with_node_worker_and_core(
       &that->worker_contexts[ii], node, ii, core_num);
   }
+  embb_mtapi_scheduler_initialize_victims(that);
   for (ii = 0; ii < that->worker_count; ii++) {
     if (MTAPI_FALSE == embb_mtapi_thread_context_start(
       &that->worker_contexts[ii], that)) {
@@ -475,12 +883,17 @@ void embb_mtapi_scheduler_finalize(embb_mtapi_scheduler_t * that) {
     embb_mtapi_thread_context_stop(&that->worker_contexts[ii]);
   }
   for (ii = 0; ii < that->worker_count; ii++) {
+    embb_mtapi_alloc_deallocate(that->worker_contexts[ii].victims);
+    that->worker_contexts[ii].victims = MTAPI_NULL;
     embb_mtapi_thread_context_finalize(&that->worker_contexts[ii]);
   }
 
   that->worker_count = 0;
-  embb_mtapi_alloc_deallocate(that->worker_contexts);
+  embb_mtapi_alloc_deallocate_cache_aligned(that->worker_contexts);
   that->worker_contexts = MTAPI_NULL;
+
+  embb_condition_destroy(&that->task_finished);
+  embb_mutex_destroy(&that->waiter_mutex);
 }
 
 embb_mtapi_scheduler_t * embb_mtapi_scheduler_new() {
@@ -524,7 +937,49 @@ mtapi_boolean_t embb_mtapi_scheduler_process_tasks(
   return result;
 }
 
-mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
+/* pushes the remaining copies of a multi-instance task to the queues of the
+   workers following first_index, so that its instances run in parallel. a
+   copy that does not fit into a queue is dropped, the others will run its
+   share of the instances. */
+static void embb_mtapi_scheduler_dispatch_instances(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_task_t * task,
+  mtapi_affinity_t * affinity,
+  mtapi_uint_t first_index,
+  mtapi_uint_t copies) {
+  mtapi_boolean_t restricted =
+    !embb_bitset_is_equal(affinity->rep, node->affinity_all.rep);
+  mtapi_uint_t priority = task->attributes.priority;
+  mtapi_uint_t index = first_index;
+  mtapi_status_t affinity_status;
+  mtapi_uint_t ii;
+
+  for (ii = 1; ii < copies; ii++) {
+    embb_mtapi_thread_context_t * context;
+    mtapi_boolean_t pushed;
+
+    /* find the next worker that may run the task */
+    do {
+      index = (index + 1) % that->worker_count;
+    } while (restricted &&
+      MTAPI_FALSE == mtapi_affinity_get(affinity, index, &affinity_status));
+
+    context = &that->worker_contexts[index];
+    pushed = embb_mtapi_task_queue_push(restricted ?
+      context->private_queue[priority] : context->queue[priority], task);
+    if (pushed) {
+      if (embb_mtapi_thread_context_wakeup(context)) {
+        embb_atomic_fetch_and_add_int(&that->sleeping_workers, -1);
+      }
+    } else {
+      embb_mtapi_task_release_copy(task, node);
+    }
+  }
+}
+
+/* pushes a task to the queues of the workers that may run it */
+static mtapi_boolean_t embb_mtapi_scheduler_dispatch_task(
   embb_mtapi_scheduler_t * that,
   embb_mtapi_task_t * task) {
   embb_mtapi_scheduler_t * scheduler = that;
@@ -538,37 +993,54 @@ mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
   if (embb_mtapi_action_pool_is_handle_valid(
     node->action_pool, task->action)) {
     embb_mtapi_queue_t* local_queue = MTAPI_NULL;
+    mtapi_uint_t copies = 1;
     /* fetch action and schedule */
     embb_mtapi_action_t* local_action =
       embb_mtapi_action_pool_get_storage_for_handle(
       node->action_pool, task->action);
 
-    mtapi_affinity_t affinity =
-      local_action->attributes.affinity & task->attributes.affinity;
+    mtapi_affinity_t affinity = local_action->attributes.affinity;
+    embb_bitset_intersect(affinity.rep, task->attributes.affinity.rep);
 
-    /* check if task is running from an ordered queue */
     if (embb_mtapi_queue_pool_is_handle_valid(node->queue_pool, task->queue)) {
       local_queue = embb_mtapi_queue_pool_get_storage_for_handle(
         node->queue_pool, task->queue);
-      if (local_queue->attributes.ordered) {
-        /* yes, modify affinity accordingly */
-        affinity = local_queue->ordered_affinity;
-      }
     }
 
     /* check affinity */
-    if (affinity == 0) {
+    if (embb_bitset_is_empty(affinity.rep)) {
       affinity = node->affinity_all;
     }
 
-    /* one more task in flight for this action */
-    embb_atomic_fetch_and_add_int(&local_action->num_tasks, 1);
+    /* instances of a task without a queue may run on several workers,
+       one copy of the task is pushed for each of them */
+    if (1 < task->attributes.num_instances && MTAPI_NULL == local_queue) {
+      copies = embb_bitset_is_equal(affinity.rep, node->affinity_all.rep) ?
+        scheduler->worker_count : embb_bitset_count(affinity.rep);
+      if (copies > task->attributes.num_instances) {
+        copies = task->attributes.num_instances;
+      }
+    }
+    embb_atomic_store_int(&task->pending_copies, (int)copies);
 
-    if (affinity == node->affinity_all) {
+    if (embb_bitset_is_equal(affinity.rep, node->affinity_all.rep)) {
       /* no affinity restrictions, schedule for stealing */
-      pushed = embb_mtapi_task_queue_push(
-        scheduler->worker_contexts[ii].queue[task->attributes.priority],
-        task);
+      embb_mtapi_thread_context_t * context =
+        embb_mtapi_scheduler_get_current_thread_context(scheduler);
+      if (NULL != context &&
+        MTAPI_TASK_SCHEDULED == embb_mtapi_task_get_state(task)) {
+        /* spawned on a worker, push into its own deque. retained tasks
+           go to the fifo queue, otherwise the worker would pick them
+           up again immediately */
+        pushed = embb_mtapi_task_deque_push_bottom(
+          context->deque[task->attributes.priority], task);
+      }
+      if (!pushed) {
+        /* spawned from outside or deque is full, use the shared queue */
+        pushed = embb_mtapi_task_queue_push(
+          scheduler->worker_contexts[ii].queue[task->attributes.priority],
+          task);
+      }
     } else {
       mtapi_status_t affinity_status;
 
@@ -586,15 +1058,171 @@ mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
     }
 
     if (pushed) {
-      /* signal all threads */
-      for (ii = 0; ii < scheduler->worker_count; ii++) {
-        embb_condition_notify_one(
-          &scheduler->worker_contexts[ii].work_available);
+      if (embb_bitset_is_equal(affinity.rep, node->affinity_all.rep)) {
+        /* any worker can take the task, wake one if there are sleepers */
+        embb_mtapi_scheduler_wakeup_any(scheduler, ii);
+      } else if (embb_mtapi_thread_context_wakeup(
+        &scheduler->worker_contexts[ii])) {
+        /* only the selected worker can run the task */
+        embb_atomic_fetch_and_add_int(&scheduler->sleeping_workers, -1);
       }
-    } else {
-      /* task could not be launched */
-      embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
+      if (1 < copies) {
+        embb_mtapi_scheduler_dispatch_instances(
+          scheduler, node, task, &affinity, ii, copies);
+      }
+    }
+  }
+
+  return pushed;
+}
+
+/* dispatches the task holding the token of an ordered queue. if it does
+   not fit into the queues of the workers, it is cancelled and the token
+   passed on, so the tasks behind it are not stuck forever. */
+static void embb_mtapi_scheduler_dispatch_ordered(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_queue_t * queue,
+  embb_mtapi_task_t * task) {
+  embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
+  while (MTAPI_NULL != task &&
+    !embb_mtapi_scheduler_dispatch_task(that, task)) {
+    embb_mtapi_task_t * next;
+    embb_mtapi_task_try_cancel(task, MTAPI_ERR_TASK_LIMIT);
+    embb_mtapi_task_finish(task, node, MTAPI_TASK_CANCELLED);
+    next = embb_mtapi_queue_ordered_pop(queue);
+    embb_mtapi_queue_task_finished(queue);
+    task = next;
+  }
+}
+
+void embb_mtapi_scheduler_reschedule_retained(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_queue_t * queue) {
+  embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
+  embb_mtapi_task_t * task;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != queue);
+
+  for (task = embb_mtapi_queue_unpark_task(queue); MTAPI_NULL != task;
+    task = embb_mtapi_queue_unpark_task(queue)) {
+    /* cancelled tasks are dispatched as well, the workers finish them */
+    embb_mtapi_task_try_change_state(
+      task, MTAPI_TASK_RETAINED, MTAPI_TASK_SCHEDULED);
+    if (!embb_mtapi_scheduler_dispatch_task(that, task)) {
+      embb_mtapi_task_try_cancel(task, MTAPI_ERR_TASK_LIMIT);
+      embb_mtapi_scheduler_drop_task(that, node, task, queue);
+    }
+  }
+}
+
+mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_task_t * task) {
+  embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+  embb_mtapi_action_t* local_action;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+
+  if (!embb_mtapi_action_pool_is_handle_valid(
+    node->action_pool, task->action)) {
+    return MTAPI_FALSE;
+  }
+  /* one more task in flight for this action, counted once however often
+     the task is dispatched */
+  local_action = embb_mtapi_action_pool_get_storage_for_handle(
+    node->action_pool, task->action);
+  embb_atomic_fetch_and_add_int(&local_action->num_tasks, 1);
+
+  /* tasks of an ordered queue get in line, only the one holding the
+     token is dispatched */
+  if (embb_mtapi_queue_pool_is_handle_valid(node->queue_pool, task->queue)) {
+    embb_mtapi_queue_t* local_queue =
+      embb_mtapi_queue_pool_get_storage_for_handle(
+        node->queue_pool, task->queue);
+    if (embb_mtapi_queue_is_ordered(local_queue)) {
+      embb_mtapi_task_t* next;
+      if (!embb_mtapi_queue_ordered_push(local_queue, task, &next)) {
+        embb_mtapi_scheduler_release_action(node, task);
+        return MTAPI_FALSE;
+      }
+      embb_mtapi_scheduler_dispatch_ordered(that, local_queue, next);
+      return MTAPI_TRUE;
+    }
+  }
+
+  if (!embb_mtapi_scheduler_dispatch_task(that, task)) {
+    /* task could not be launched */
+    embb_mtapi_scheduler_release_action(node, task);
+    return MTAPI_FALSE;
+  }
+  return MTAPI_TRUE;
+}
+
+mtapi_uint_t embb_mtapi_scheduler_schedule_tasks(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_task_t ** tasks,
+  mtapi_uint_t count) {
+  embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+  embb_mtapi_action_t* local_action;
+  mtapi_affinity_t affinity;
+  mtapi_uint_t priority;
+  mtapi_uint_t start_index;
+  mtapi_uint_t pushed = 0;
+  mtapi_uint_t ii;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+  assert(MTAPI_NULL != tasks);
+
+  if (0 == count || !embb_mtapi_action_pool_is_handle_valid(
+    node->action_pool, tasks[0]->action)) {
+    return 0;
+  }
+  local_action = embb_mtapi_action_pool_get_storage_for_handle(
+    node->action_pool, tasks[0]->action);
+
+  affinity = local_action->attributes.affinity;
+  embb_bitset_intersect(affinity.rep, tasks[0]->attributes.affinity.rep);
+  if ((!embb_bitset_is_empty(affinity.rep) &&
+    !embb_bitset_is_equal(affinity.rep, node->affinity_all.rep)) ||
+    1 < tasks[0]->attributes.num_instances) {
+    /* restricted and multi-instance tasks are scheduled one by one */
+    while (pushed < count &&
+      embb_mtapi_scheduler_schedule_task(that, tasks[pushed])) {
+      pushed++;
     }
+    return pushed;
+  }
+
+  /* account for all tasks up front, some may finish before we are done */
+  embb_atomic_fetch_and_add_int(&local_action->num_tasks, (int)count);
+
+  /* give each worker a contiguous slice of the remaining tasks, if a queue
+     is full its share goes to the next workers */
+  priority = tasks[0]->attributes.priority;
+  start_index = tasks[0]->handle.id % that->worker_count;
+  for (ii = 0; ii < that->worker_count && pushed < count; ii++) {
+    embb_mtapi_thread_context_t * context =
+      &that->worker_contexts[(start_index + ii) % that->worker_count];
+    mtapi_uint_t workers_left = that->worker_count - ii;
+    mtapi_uint_t slice = (count - pushed + workers_left - 1) / workers_left;
+    mtapi_uint_t slice_pushed = embb_mtapi_task_queue_push_n(
+      context->queue[priority], &tasks[pushed], slice);
+    pushed += slice_pushed;
+    /* one notification per worker instead of one per task */
+    if (0 < slice_pushed &&
+      0 < embb_atomic_load_int(&that->sleeping_workers) &&
+      embb_mtapi_thread_context_wakeup(context)) {
+      embb_atomic_fetch_and_add_int(&that->sleeping_workers, -1);
+    }
+  }
+
+  if (pushed < count) {
+    /* the rest could not be launched */
+    embb_atomic_fetch_and_add_int(&local_action->num_tasks,
+      -(int)(count - pushed));
   }
 
   return pushed;
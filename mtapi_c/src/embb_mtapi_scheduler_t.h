@@ -29,6 +29,8 @@
 
 #include <embb/mtapi/c/mtapi.h>
 #include <embb/base/c/atomic.h>
+#include <embb/base/c/mutex.h>
+#include <embb/base/c/condition_variable.h>
 
 #include <embb_mtapi_task_visitor_function_t.h>
 
@@ -58,10 +60,21 @@ enum embb_mtapi_scheduler_mode_enum {
   WORK_STEAL_VHPF = 0,
   // Local First. Steal if all local queues are empty.
   WORK_STEAL_LF   = 1,
+  // Like VHPF, but stealing starts at a randomly chosen victim.
+  WORK_STEAL_RANDOM_VHPF = 2,
+  // Like VHPF, but a successful steal takes up to half of the victim's tasks.
+  WORK_STEAL_HALF_VHPF = 3,
 
   NUM_SCHEDULER_MODES
 };
 
+/**
+ * Maximum number of tasks taken by a single steal in WORK_STEAL_HALF_VHPF
+ * mode.
+ * \memberof embb_mtapi_scheduler_struct
+ */
+#define EMBB_MTAPI_SCHEDULER_STEAL_HALF_MAX 32
+
 /**
  * Scheduler mode type.
  * \memberof embb_mtapi_scheduler_struct
@@ -85,6 +98,11 @@ struct embb_mtapi_scheduler_struct {
   embb_mtapi_scheduler_mode_t mode;
 
   embb_atomic_int affine_task_counter;
+  embb_atomic_int sleeping_workers;
+
+  // threads that are not workers block here while waiting for a task
+  embb_mutex_t waiter_mutex;
+  embb_condition_t task_finished;
 };
 
 /**
@@ -110,13 +128,21 @@ embb_mtapi_scheduler_worker_func_t *
 embb_mtapi_scheduler_worker_func(embb_mtapi_scheduler_t * that);
 
 /**
- * Wait for a given task and schedule new ones while waiting.
+ * Wait for a given task. Worker threads schedule new tasks while waiting,
+ * other threads block until the task has finished.
  * \memberof embb_mtapi_scheduler_struct
  */
 mtapi_boolean_t embb_mtapi_scheduler_wait_for_task(
   embb_mtapi_task_t * task,
   mtapi_timeout_t timeout);
 
+/**
+ * Wake up all threads blocked in embb_mtapi_scheduler_wait_for_task(), so
+ * they can check whether their task has finished.
+ * \memberof embb_mtapi_scheduler_struct
+ */
+void embb_mtapi_scheduler_notify_waiters(embb_mtapi_scheduler_t * that);
+
 /**
  * Get a task from any of the available queues.
  * \memberof embb_mtapi_scheduler_struct
@@ -165,7 +191,8 @@ embb_mtapi_scheduler_t * embb_mtapi_scheduler_new();
 void embb_mtapi_scheduler_delete(embb_mtapi_scheduler_t * that);
 
 /**
- * Default constructor. Using default scheduling strategy.
+ * Default constructor. Using the scheduling strategy set in the node
+ * attributes.
  * \memberof embb_mtapi_scheduler_struct
  * \returns MTAPI_TRUE on success, MTAPI_FALSE on error
  */
@@ -187,7 +214,28 @@ mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
 void embb_mtapi_scheduler_finalize(embb_mtapi_scheduler_t * that);
 
 /**
- * Apply visitor to all Tasks in the queues of the scheduler.
+ * Orders the other workers of each worker for stealing, the ones in the
+ * same NUMA domain first. Called by the constructor, the victim lists are
+ * freed by the destructor.
+ * \memberof embb_mtapi_scheduler_struct
+ */
+void embb_mtapi_scheduler_initialize_victims(embb_mtapi_scheduler_t * that);
+
+/**
+ * Returns the worker to steal from in the given attempt, counting from 0
+ * to worker_count - 2. The offset rotates the start within the workers of
+ * the same and of the other NUMA domains.
+ * \memberof embb_mtapi_scheduler_struct
+ */
+embb_mtapi_thread_context_t * embb_mtapi_scheduler_get_victim(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_thread_context_t * thread_context,
+  mtapi_uint_t offset,
+  mtapi_uint_t attempt);
+
+/**
+ * Apply visitor to all Tasks in the queues of the scheduler, apart from
+ * the ones in the deques of the workers.
  * \memberof embb_mtapi_scheduler_struct
  */
 mtapi_boolean_t embb_mtapi_scheduler_process_tasks(
@@ -204,6 +252,28 @@ mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
   embb_mtapi_scheduler_t * that,
   embb_mtapi_task_t * task);
 
+/**
+ * Put the tasks a retaining queue parked while it was disabled back into
+ * the queues of the scheduler.
+ * \memberof embb_mtapi_scheduler_struct
+ */
+void embb_mtapi_scheduler_reschedule_retained(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_queue_t * queue);
+
+/**
+ * Put several tasks of the same action, priority, group and affinity into
+ * the queues of the scheduler. The tasks are spread across the workers in
+ * contiguous slices and each sleeping worker that got tasks is woken up
+ * once. Returns the number of tasks scheduled, these are the first ones of
+ * \c tasks.
+ * \memberof embb_mtapi_scheduler_struct
+ */
+mtapi_uint_t embb_mtapi_scheduler_schedule_tasks(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_task_t ** tasks,
+  mtapi_uint_t count);
+
 
 #ifdef __cplusplus
 }
@@ -24,8 +24,117 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+
+#include <embb/base/c/internal/config.h>
+#include <embb/base/c/internal/platform.h>
+
+#ifdef EMBB_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
 #include <embb_mtapi_spinlock_t.h>
 
+/* upper bound for the number of pause instructions between two reads of
+   the lock */
+#define EMBB_MTAPI_SPINLOCK_MAX_BACKOFF 1024
+
+#ifdef EMBB_MTAPI_SPINLOCK_STATISTICS
+
+/* number of counters, threads are assigned to them round robin */
+#define EMBB_MTAPI_SPINLOCK_STATISTICS_SHARDS 64
+
+/* one counter per cache line, so spinning threads do not contend on the
+   statistics in addition to the lock itself */
+typedef struct {
+  embb_atomic_unsigned_long spins;
+  char padding[EMBB_CACHE_LINE_SIZE - sizeof(embb_atomic_unsigned_long)];
+} embb_mtapi_spinlock_shard_t;
+
+static embb_mtapi_spinlock_shard_t
+  embb_mtapi_spinlock_shards[EMBB_MTAPI_SPINLOCK_STATISTICS_SHARDS];
+static embb_atomic_unsigned_int embb_mtapi_spinlock_next_shard = { 0 };
+EMBB_THREAD_SPECIFIC embb_mtapi_spinlock_shard_t *
+  embb_mtapi_spinlock_local_shard = NULL;
+
+static void embb_mtapi_spinlock_count_spin() {
+  if (NULL == embb_mtapi_spinlock_local_shard) {
+    unsigned int shard = embb_atomic_fetch_and_add_unsigned_int(
+      &embb_mtapi_spinlock_next_shard, 1);
+    embb_mtapi_spinlock_local_shard = &embb_mtapi_spinlock_shards[
+      shard % EMBB_MTAPI_SPINLOCK_STATISTICS_SHARDS];
+  }
+  embb_atomic_fetch_and_add_unsigned_long(
+    &embb_mtapi_spinlock_local_shard->spins, 1);
+}
+
+void embb_mtapi_spinlock_reset_spins() {
+  int ii;
+  for (ii = 0; ii < EMBB_MTAPI_SPINLOCK_STATISTICS_SHARDS; ii++) {
+    embb_atomic_store_unsigned_long(&embb_mtapi_spinlock_shards[ii].spins, 0);
+  }
+}
+
+unsigned long embb_mtapi_spinlock_get_spins() {
+  unsigned long spins = 0;
+  int ii;
+  for (ii = 0; ii < EMBB_MTAPI_SPINLOCK_STATISTICS_SHARDS; ii++) {
+    spins +=
+      embb_atomic_load_unsigned_long(&embb_mtapi_spinlock_shards[ii].spins);
+  }
+  return spins;
+}
+
+#else
+
+#define embb_mtapi_spinlock_count_spin()
+
+void embb_mtapi_spinlock_reset_spins() {
+}
+
+unsigned long embb_mtapi_spinlock_get_spins() {
+  return 0;
+}
+
+#endif
+
+void embb_mtapi_spinlock_pause() {
+#if defined(EMBB_ARCH_X86) && defined(EMBB_COMPILER_MSVC)
+  _mm_pause();
+#elif defined(EMBB_ARCH_X86) && defined(EMBB_COMPILER_GNUC)
+  __asm__ __volatile__ ("pause" : : : "memory");
+#elif defined(EMBB_ARCH_ARM) && defined(EMBB_COMPILER_GNUC)
+  __asm__ __volatile__ ("yield" : : : "memory");
+#endif
+}
+
+/* back off after a failed attempt to take the lock, then wait until the
+   lock looks free, only reading it to keep the cache line shared. if
+   spin_count is given, every read counts against it. returns MTAPI_FALSE
+   if the spin count ran out before the lock looked free */
+static mtapi_boolean_t embb_mtapi_spinlock_wait(
+  embb_mtapi_spinlock_t * that,
+  mtapi_uint_t * backoff,
+  mtapi_uint_t * spin_count) {
+  mtapi_uint_t ii;
+  for (ii = 0; ii < *backoff; ii++) {
+    embb_mtapi_spinlock_pause();
+  }
+  /* only failed attempts make the backoff grow, not reads of a busy lock */
+  if (*backoff < EMBB_MTAPI_SPINLOCK_MAX_BACKOFF) {
+    *backoff <<= 1;
+  }
+  while (0 != embb_atomic_load_int(that)) {
+    if (MTAPI_NULL != spin_count) {
+      (*spin_count)--;
+      if (0 == *spin_count) {
+        return MTAPI_FALSE;
+      }
+    }
+    embb_mtapi_spinlock_pause();
+  }
+  return MTAPI_TRUE;
+}
+
 void embb_mtapi_spinlock_initialize(embb_mtapi_spinlock_t * that) {
   embb_atomic_store_int(that, 0);
 }
@@ -34,13 +143,12 @@ void embb_mtapi_spinlock_finalize(embb_mtapi_spinlock_t * that) {
   embb_atomic_store_int(that, 0);
 }
 
-embb_atomic_int embb_mtapi_spinlock_spins = { 0 };
-
 mtapi_boolean_t embb_mtapi_spinlock_acquire(embb_mtapi_spinlock_t * that) {
   int expected = 0;
+  mtapi_uint_t backoff = 1;
   while (0 == embb_atomic_compare_and_swap_int(that, &expected, 1)) {
-    /* empty */
-    embb_atomic_fetch_and_add_int(&embb_mtapi_spinlock_spins, 1);
+    embb_mtapi_spinlock_count_spin();
+    embb_mtapi_spinlock_wait(that, &backoff, MTAPI_NULL);
     expected = 0;
   }
   return MTAPI_TRUE;
@@ -51,12 +159,16 @@ mtapi_boolean_t embb_mtapi_spinlock_acquire_with_spincount(
   mtapi_uint_t max_spin_count) {
   int expected = 0;
   mtapi_uint_t spin_count = max_spin_count;
+  mtapi_uint_t backoff = 1;
   while (0 == embb_atomic_compare_and_swap_int(that, &expected, 1)) {
-    embb_atomic_fetch_and_add_int(&embb_mtapi_spinlock_spins, 1);
+    embb_mtapi_spinlock_count_spin();
     spin_count--;
     if (0 == spin_count) {
       return MTAPI_FALSE;
     }
+    if (!embb_mtapi_spinlock_wait(that, &backoff, &spin_count)) {
+      return MTAPI_FALSE;
+    }
     expected = 0;
   }
 
@@ -47,6 +47,26 @@ mtapi_boolean_t embb_mtapi_spinlock_acquire_with_spincount(
   mtapi_uint_t max_spin_count);
 mtapi_boolean_t embb_mtapi_spinlock_release(embb_mtapi_spinlock_t * that);
 
+/**
+ * Tells the processor that the caller is spin waiting. This saves power and
+ * frees resources for a hyperthreaded sibling.
+ */
+void embb_mtapi_spinlock_pause();
+
+/* ---- STATISTICS --------------------------------------------------------- */
+
+/**
+ * Resets the number of failed lock attempts. Only counted if built with
+ * EMBB_MTAPI_SPINLOCK_STATISTICS, this is a no-op otherwise.
+ */
+void embb_mtapi_spinlock_reset_spins();
+
+/**
+ * Returns the number of failed lock attempts since the last reset. Always
+ * 0 if not built with EMBB_MTAPI_SPINLOCK_STATISTICS.
+ */
+unsigned long embb_mtapi_spinlock_get_spins();
+
 
 #ifdef __cplusplus
 }
@@ -77,8 +77,7 @@ void mtapi_context_status_set(
 
   if (MTAPI_NULL != task_context) {
     embb_mtapi_thread_context_t* local_context =
-      (embb_mtapi_thread_context_t*)embb_tss_get(
-        &(task_context->thread_context->tss_id));
+      embb_mtapi_thread_context_get_current();
 
     if (local_context == task_context->thread_context) {
       /* for remote actions the result shall be transferred to the
@@ -158,10 +157,10 @@ void mtapi_context_runtime_notify(
   embb_mtapi_log_trace("mtapi_context_runtime_notify() called\n");
 
   if (MTAPI_NULL != task_context) {
-    mtapi_task_context_t* local_context = (mtapi_task_context_t*) embb_tss_get(
-      &(task_context->thread_context->tss_id));
+    embb_mtapi_thread_context_t* local_context =
+      embb_mtapi_thread_context_get_current();
 
-    if (local_context == task_context) {
+    if (local_context == task_context->thread_context) {
       local_status = MTAPI_SUCCESS;
     } else {
       local_status = MTAPI_ERR_CONTEXT_OUTOFCONTEXT;
@@ -183,11 +182,10 @@ mtapi_task_state_t mtapi_context_taskstate_get(
 
   if (MTAPI_NULL != task_context) {
     embb_mtapi_thread_context_t* local_context =
-      (embb_mtapi_thread_context_t*)embb_tss_get(
-        &(task_context->thread_context->tss_id));
+      embb_mtapi_thread_context_get_current();
 
     if (local_context == task_context->thread_context) {
-      task_state = task_context->task->state;
+      task_state = embb_mtapi_task_get_state(task_context->task);
       local_status = MTAPI_SUCCESS;
     } else {
       local_status = MTAPI_ERR_CONTEXT_OUTOFCONTEXT;
@@ -211,8 +209,7 @@ mtapi_uint_t mtapi_context_instnum_get(
 
   if (MTAPI_NULL != task_context) {
     embb_mtapi_thread_context_t* local_context =
-      (embb_mtapi_thread_context_t*)embb_tss_get(
-        &(task_context->thread_context->tss_id));
+      embb_mtapi_thread_context_get_current();
 
     if (local_context == task_context->thread_context) {
       instnum = task_context->instance_num;
@@ -239,8 +236,7 @@ mtapi_uint_t mtapi_context_numinst_get(
 
   if (MTAPI_NULL != task_context) {
     embb_mtapi_thread_context_t* local_context =
-      (embb_mtapi_thread_context_t*)embb_tss_get(
-        &(task_context->thread_context->tss_id));
+      embb_mtapi_thread_context_get_current();
 
     if (local_context == task_context->thread_context) {
       numinst = task_context->num_instances;
@@ -266,8 +262,7 @@ mtapi_uint_t mtapi_context_corenum_get(
 
   if (MTAPI_NULL != task_context) {
     embb_mtapi_thread_context_t* local_context =
-      (embb_mtapi_thread_context_t*)embb_tss_get(
-        &(task_context->thread_context->tss_id));
+      embb_mtapi_thread_context_get_current();
 
     if (local_context == task_context->thread_context) {
       corenum = task_context->thread_context->core_num;
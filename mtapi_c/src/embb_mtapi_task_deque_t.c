@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <assert.h>
+
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/atomic.h>
+
+#include <embb_mtapi_task_deque_t.h>
+#include <embb_mtapi_task_t.h>
+#include <embb_mtapi_alloc.h>
+
+
+/* ---- CLASS MEMBERS ------------------------------------------------------ */
+
+void embb_mtapi_task_deque_initialize_with_capacity(
+  embb_mtapi_task_deque_t* that,
+  mtapi_uint_t capacity) {
+  mtapi_uint_t ii;
+
+  assert(MTAPI_NULL != that);
+
+  /* round up to power of two, so indices can be masked */
+  that->capacity = 1;
+  while (that->capacity < capacity) {
+    that->capacity <<= 1;
+  }
+  that->mask = that->capacity - 1;
+  that->task_buffer = (embb_mtapi_task_t * volatile *)
+    embb_mtapi_alloc_allocate(sizeof(embb_mtapi_task_t *)*that->capacity);
+  for (ii = 0; ii < that->capacity; ii++) {
+    that->task_buffer[ii] = MTAPI_NULL;
+  }
+  embb_atomic_store_unsigned_int(&that->top, 0);
+  embb_atomic_store_unsigned_int(&that->bottom, 0);
+}
+
+void embb_mtapi_task_deque_finalize(embb_mtapi_task_deque_t* that) {
+  assert(MTAPI_NULL != that);
+
+  embb_mtapi_alloc_deallocate((void*)that->task_buffer);
+  that->task_buffer = MTAPI_NULL;
+  that->capacity = 0;
+  that->mask = 0;
+  embb_atomic_store_unsigned_int(&that->top, 0);
+  embb_atomic_store_unsigned_int(&that->bottom, 0);
+}
+
+mtapi_boolean_t embb_mtapi_task_deque_push_bottom(
+  embb_mtapi_task_deque_t* that,
+  embb_mtapi_task_t * task) {
+  unsigned int bottom;
+  unsigned int top;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != task);
+
+  bottom = embb_atomic_load_unsigned_int(&that->bottom);
+  top = embb_atomic_load_unsigned_int(&that->top);
+  if (bottom - top >= that->capacity) {
+    /* full */
+    return MTAPI_FALSE;
+  }
+
+  that->task_buffer[bottom & that->mask] = task;
+  /* publish task, the store orders the buffer write before it */
+  embb_atomic_store_unsigned_int(&that->bottom, bottom + 1);
+
+  return MTAPI_TRUE;
+}
+
+embb_mtapi_task_t * embb_mtapi_task_deque_pop_bottom(
+  embb_mtapi_task_deque_t* that) {
+  embb_mtapi_task_t * task = MTAPI_NULL;
+  unsigned int bottom;
+  unsigned int top;
+
+  assert(MTAPI_NULL != that);
+
+  /* cheap check to avoid the fence if there is nothing to pop */
+  bottom = embb_atomic_load_unsigned_int(&that->bottom);
+  top = embb_atomic_load_unsigned_int(&that->top);
+  if ((int)(bottom - top) <= 0) {
+    return MTAPI_NULL;
+  }
+
+  /* reserve the bottom entry, the store needs to be visible to thieves
+     before top is read again */
+  bottom--;
+  embb_atomic_store_unsigned_int(&that->bottom, bottom);
+  embb_atomic_memory_barrier();
+  top = embb_atomic_load_unsigned_int(&that->top);
+
+  if ((int)(bottom - top) >= 0) {
+    task = that->task_buffer[bottom & that->mask];
+    if (bottom == top) {
+      /* last entry, race against thieves */
+      if (!embb_atomic_compare_and_swap_unsigned_int(
+        &that->top, &top, top + 1)) {
+        /* a thief was faster */
+        task = MTAPI_NULL;
+      }
+      embb_atomic_store_unsigned_int(&that->bottom, bottom + 1);
+    }
+  } else {
+    /* deque was emptied by thieves in the meantime */
+    embb_atomic_store_unsigned_int(&that->bottom, bottom + 1);
+  }
+
+  return task;
+}
+
+embb_mtapi_task_t * embb_mtapi_task_deque_steal_top(
+  embb_mtapi_task_deque_t* that) {
+  embb_mtapi_task_t * task = MTAPI_NULL;
+  unsigned int bottom;
+  unsigned int top;
+
+  assert(MTAPI_NULL != that);
+
+  top = embb_atomic_load_unsigned_int(&that->top);
+  embb_atomic_memory_barrier();
+  bottom = embb_atomic_load_unsigned_int(&that->bottom);
+
+  if ((int)(bottom - top) > 0) {
+    task = that->task_buffer[top & that->mask];
+    if (!embb_atomic_compare_and_swap_unsigned_int(
+      &that->top, &top, top + 1)) {
+      /* lost the race against the owner or another thief */
+      task = MTAPI_NULL;
+    }
+  }
+
+  return task;
+}
+
+mtapi_uint_t embb_mtapi_task_deque_steal_half(
+  embb_mtapi_task_deque_t* that,
+  embb_mtapi_task_t ** tasks,
+  mtapi_uint_t max_tasks) {
+  mtapi_uint_t count = 0;
+  mtapi_uint_t half;
+  int size;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != tasks);
+
+  size = (int)(embb_atomic_load_unsigned_int(&that->bottom) -
+    embb_atomic_load_unsigned_int(&that->top));
+  half = (0 < size) ? ((mtapi_uint_t)size + 1) / 2 : 1;
+  if (half > max_tasks) {
+    half = max_tasks;
+  }
+
+  /* each task is taken by a separate compare and swap, taking several at
+     once could race with the owner popping from the bottom */
+  while (count < half) {
+    embb_mtapi_task_t * task = embb_mtapi_task_deque_steal_top(that);
+    if (MTAPI_NULL == task) {
+      break;
+    }
+    tasks[count] = task;
+    count++;
+  }
+
+  return count;
+}
+
+mtapi_uint_t embb_mtapi_task_deque_get_free_slots(
+  embb_mtapi_task_deque_t* that) {
+  int size;
+
+  assert(MTAPI_NULL != that);
+
+  size = (int)(embb_atomic_load_unsigned_int(&that->bottom) -
+    embb_atomic_load_unsigned_int(&that->top));
+  if (0 >= size) {
+    return that->capacity;
+  }
+  return that->capacity - (mtapi_uint_t)size;
+}
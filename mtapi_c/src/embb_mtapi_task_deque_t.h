@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MTAPI_C_SRC_EMBB_MTAPI_TASK_DEQUE_T_H_
+#define MTAPI_C_SRC_EMBB_MTAPI_TASK_DEQUE_T_H_
+
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/atomic.h>
+#include <embb/base/c/internal/config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ---- FORWARD DECLARATIONS ----------------------------------------------- */
+
+typedef struct embb_mtapi_task_struct embb_mtapi_task_t;
+
+
+/* ---- CLASS DECLARATION -------------------------------------------------- */
+
+/**
+ * \internal
+ * Work stealing task deque class.
+ *
+ * Bounded Chase-Lev deque. The owning worker pushes and pops at the bottom
+ * (LIFO) without synchronization apart from memory ordering, other workers
+ * steal from the top (FIFO) and only contend on a compare and swap.
+ * Push and pop at the bottom must only be called by the owning worker.
+ *
+ * \ingroup INTERNAL
+ */
+struct embb_mtapi_task_deque_struct {
+  embb_mtapi_task_t * volatile * task_buffer;
+  mtapi_uint_t capacity;
+  mtapi_uint_t mask;
+  /* thieves update top, the owner updates bottom, keep them apart */
+  embb_atomic_unsigned_int top;
+  char padding[EMBB_CACHE_LINE_SIZE];
+  embb_atomic_unsigned_int bottom;
+};
+
+/**
+ * Task deque type.
+ * \memberof embb_mtapi_task_deque_struct
+ */
+typedef struct embb_mtapi_task_deque_struct embb_mtapi_task_deque_t;
+
+/**
+ * Constructor with configurable capacity. The capacity is rounded up to the
+ * next power of two.
+ * \memberof embb_mtapi_task_deque_struct
+ */
+void embb_mtapi_task_deque_initialize_with_capacity(
+  embb_mtapi_task_deque_t* that,
+  mtapi_uint_t capacity);
+
+/**
+ * Destructor.
+ * \memberof embb_mtapi_task_deque_struct
+ */
+void embb_mtapi_task_deque_finalize(embb_mtapi_task_deque_t* that);
+
+/**
+ * Push a task to the bottom of the deque. Returns MTAPI_TRUE if successful
+ * and MTAPI_FALSE if the deque is full. Owner only.
+ * \memberof embb_mtapi_task_deque_struct
+ */
+mtapi_boolean_t embb_mtapi_task_deque_push_bottom(
+  embb_mtapi_task_deque_t* that,
+  embb_mtapi_task_t * task);
+
+/**
+ * Pop a task from the bottom of the deque. Returns MTAPI_NULL if the deque
+ * is empty. Owner only.
+ * \memberof embb_mtapi_task_deque_struct
+ */
+embb_mtapi_task_t * embb_mtapi_task_deque_pop_bottom(
+  embb_mtapi_task_deque_t* that);
+
+/**
+ * Steal a task from the top of the deque. Returns MTAPI_NULL if the deque
+ * is empty or another thread won the race for the topmost task.
+ * \memberof embb_mtapi_task_deque_struct
+ */
+embb_mtapi_task_t * embb_mtapi_task_deque_steal_top(
+  embb_mtapi_task_deque_t* that);
+
+/**
+ * Steal up to half of the tasks (but at least one) from the top of the deque,
+ * at most \c max_tasks. The tasks are stored oldest first in \c tasks.
+ * Returns the number of stolen tasks.
+ * \memberof embb_mtapi_task_deque_struct
+ */
+mtapi_uint_t embb_mtapi_task_deque_steal_half(
+  embb_mtapi_task_deque_t* that,
+  embb_mtapi_task_t ** tasks,
+  mtapi_uint_t max_tasks);
+
+/**
+ * Returns the number of tasks that can be pushed before the deque is full.
+ * Only exact if called by the owner, thieves may free more slots at any
+ * time.
+ * \memberof embb_mtapi_task_deque_struct
+ */
+mtapi_uint_t embb_mtapi_task_deque_get_free_slots(
+  embb_mtapi_task_deque_t* that);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MTAPI_C_SRC_EMBB_MTAPI_TASK_DEQUE_T_H_
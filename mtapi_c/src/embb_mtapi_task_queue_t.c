@@ -102,6 +102,35 @@ embb_mtapi_task_t * embb_mtapi_task_queue_pop(embb_mtapi_task_queue_t* that) {
   return task;
 }
 
+mtapi_uint_t embb_mtapi_task_queue_pop_half(
+  embb_mtapi_task_queue_t* that,
+  embb_mtapi_task_t ** tasks,
+  mtapi_uint_t max_tasks) {
+  mtapi_uint_t count = 0;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != tasks);
+
+  if (embb_mtapi_spinlock_acquire_with_spincount(&that->lock, 128)) {
+    mtapi_uint_t half = (that->tasks_available + 1) / 2;
+    if (half > max_tasks) {
+      half = max_tasks;
+    }
+    for (count = 0; count < half; count++) {
+      tasks[count] = that->task_buffer[that->get_task_position];
+      that->task_buffer[that->get_task_position] = MTAPI_NULL;
+      that->get_task_position++;
+      if (that->attributes.limit <= that->get_task_position) {
+        that->get_task_position = 0;
+      }
+    }
+    that->tasks_available -= count;
+    embb_mtapi_spinlock_release(&that->lock);
+  }
+
+  return count;
+}
+
 mtapi_boolean_t embb_mtapi_task_queue_push(
   embb_mtapi_task_queue_t* that,
   embb_mtapi_task_t * task) {
@@ -132,6 +161,34 @@ mtapi_boolean_t embb_mtapi_task_queue_push(
   return result;
 }
 
+mtapi_uint_t embb_mtapi_task_queue_push_n(
+  embb_mtapi_task_queue_t* that,
+  embb_mtapi_task_t ** tasks,
+  mtapi_uint_t count) {
+  mtapi_uint_t pushed = 0;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != tasks);
+
+  if (embb_mtapi_spinlock_acquire(&that->lock)) {
+    mtapi_uint_t free_slots = that->attributes.limit - that->tasks_available;
+    if (count > free_slots) {
+      count = free_slots;
+    }
+    for (pushed = 0; pushed < count; pushed++) {
+      that->task_buffer[that->put_task_position] = tasks[pushed];
+      that->put_task_position++;
+      if (that->attributes.limit <= that->put_task_position) {
+        that->put_task_position = 0;
+      }
+    }
+    that->tasks_available += pushed;
+    embb_mtapi_spinlock_release(&that->lock);
+  }
+
+  return pushed;
+}
+
 mtapi_boolean_t embb_mtapi_task_queue_process(
   embb_mtapi_task_queue_t * that,
   embb_mtapi_task_visitor_function_t process,
@@ -146,7 +203,7 @@ mtapi_boolean_t embb_mtapi_task_queue_process(
   if (embb_mtapi_spinlock_acquire(&that->lock)) {
     idx = that->get_task_position;
     for (ii = 0; ii < that->tasks_available; ii++) {
-      result = process(that->task_buffer[ii], user_data);
+      result = process(that->task_buffer[idx], user_data);
       if (MTAPI_FALSE == result) {
         break;
       }
@@ -92,6 +92,17 @@ void embb_mtapi_task_queue_finalize(embb_mtapi_task_queue_t* that);
  */
 embb_mtapi_task_t * embb_mtapi_task_queue_pop(embb_mtapi_task_queue_t* that);
 
+/**
+ * Pop up to half of the tasks (but at least one) from the queue, at most
+ * \c max_tasks, under a single lock acquisition. The tasks are stored in
+ * queue order in \c tasks. Returns the number of tasks popped.
+ * \memberof embb_mtapi_task_queue_struct
+ */
+mtapi_uint_t embb_mtapi_task_queue_pop_half(
+  embb_mtapi_task_queue_t* that,
+  embb_mtapi_task_t ** tasks,
+  mtapi_uint_t max_tasks);
+
 /**
  * Push a task into the queue. Returns MTAPI_TRUE if successfull and
  * MTAPI_FALSE if the queue is full or cannot be locked in time.
@@ -101,6 +112,16 @@ mtapi_boolean_t embb_mtapi_task_queue_push(
   embb_mtapi_task_queue_t* that,
   embb_mtapi_task_t * task);
 
+/**
+ * Push up to \c count tasks into the queue under a single lock acquisition.
+ * Returns the number of tasks pushed, these are the first ones of \c tasks.
+ * \memberof embb_mtapi_task_queue_struct
+ */
+mtapi_uint_t embb_mtapi_task_queue_push_n(
+  embb_mtapi_task_queue_t* that,
+  embb_mtapi_task_t ** tasks,
+  mtapi_uint_t count);
+
 
 /**
  * Process all elements of the task queue using the given functor.
@@ -25,8 +25,11 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
 #include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/time.h>
+#include <embb/base/c/thread.h>
 
 #include <embb_mtapi_log.h>
 #include <mtapi_status_t.h>
@@ -42,6 +45,9 @@
 #include <embb_mtapi_attr.h>
 #include <embb_mtapi_task_context_t.h>
 
+/* tasks of a batch are set up and scheduled in chunks of this size */
+#define EMBB_MTAPI_TASK_BATCH_CHUNK 64
+
 
 /* ---- POOL STORAGE FUNCTIONS --------------------------------------------- */
 
@@ -79,29 +85,235 @@ void embb_mtapi_task_initialize(embb_mtapi_task_t* that) {
 
   that->action.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
   that->job.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
-  that->state = MTAPI_TASK_ERROR;
+  embb_atomic_store_int(&that->state, MTAPI_TASK_ERROR);
+  embb_atomic_store_int(&that->num_waiters, 0);
   that->task_id = MTAPI_TASK_ID_NONE;
   that->group.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
   that->queue.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
   that->error_code = MTAPI_SUCCESS;
   embb_atomic_store_unsigned_int(&that->current_instance, 0);
-  embb_mtapi_spinlock_initialize(&that->state_lock);
+  embb_atomic_store_int(&that->pending_copies, 1);
+  embb_atomic_store_int(&that->continuations, 0);
+  that->next_continuation = 0;
 }
 
 void embb_mtapi_task_finalize(embb_mtapi_task_t* that) {
   assert(MTAPI_NULL != that);
 
   embb_mtapi_task_initialize(that);
-  embb_mtapi_spinlock_finalize(&that->state_lock);
 }
 
-void embb_mtapi_task_execute(
+/* wakes up threads blocked on the task, has to be called after the task
+   has finished */
+static void embb_mtapi_task_notify_waiters(embb_mtapi_task_t* that) {
+  if (0 < embb_atomic_load_int(&that->num_waiters)) {
+    embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+    embb_mtapi_scheduler_notify_waiters(node->scheduler);
+  }
+}
+
+/* finishes the task like embb_mtapi_task_finish, but discounts it only for
+   the given action, which may be invalid if the task was never counted */
+static void embb_mtapi_task_finish_for_action(
+  embb_mtapi_task_t* that,
+  embb_mtapi_node_t* node,
+  mtapi_task_state_t state,
+  mtapi_action_hndl_t action) {
+  /* a waiting thread may delete the task as soon as it has finished, so
+     everything needed afterwards is fetched up front */
+  mtapi_group_hndl_t group = that->group;
+  int continuations = embb_atomic_swap_int(
+    &that->continuations, EMBB_MTAPI_TASK_CONTINUATIONS_CLOSED);
+  int running = MTAPI_TASK_RUNNING;
+
+  assert(MTAPI_NULL != node);
+
+  embb_atomic_memory_barrier();
+
+  if (embb_atomic_compare_and_swap_int(&that->state, &running, (int)state)) {
+    embb_mtapi_task_notify_waiters(that);
+  } else {
+    int pending = EMBB_MTAPI_TASK_CANCEL_PENDING;
+    /* task was cancelled before it was done, the group must not see it
+       before its error code is written */
+    while (EMBB_MTAPI_TASK_CANCELLING == embb_atomic_load_int(&that->state)) {
+      embb_thread_yield();
+    }
+    /* nobody holds the task any more, release the waiters */
+    if (embb_atomic_compare_and_swap_int(
+      &that->state, &pending, MTAPI_TASK_CANCELLED)) {
+      embb_mtapi_task_notify_waiters(that);
+    }
+  }
+
+  /* one task less in flight for the action */
+  if (embb_mtapi_action_pool_is_handle_valid(node->action_pool, action)) {
+    embb_mtapi_action_t* local_action =
+      embb_mtapi_action_pool_get_storage_for_handle(
+        node->action_pool, action);
+    embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
+  }
+
+  /* is task associated with a group? */
+  if (embb_mtapi_group_pool_is_handle_valid(node->group_pool, group)) {
+    embb_mtapi_group_t* local_group =
+      embb_mtapi_group_pool_get_storage_for_handle(node->group_pool, group);
+    embb_mtapi_group_task_finished(local_group, node, that);
+  }
+
+  embb_mtapi_task_start_continuations(node, continuations);
+}
+
+void embb_mtapi_task_finish(
+  embb_mtapi_task_t* that,
+  embb_mtapi_node_t* node,
+  mtapi_task_state_t state) {
+  embb_mtapi_task_finish_for_action(that, node, state, that->action);
+}
+
+mtapi_boolean_t embb_mtapi_task_add_continuation(
+  embb_atomic_int* list,
+  embb_mtapi_task_t* continuation) {
+  int head = embb_atomic_load_int(list);
+
+  assert(MTAPI_NULL != continuation);
+
+  do {
+    if (EMBB_MTAPI_TASK_CONTINUATIONS_CLOSED == head) {
+      return MTAPI_FALSE;
+    }
+    continuation->next_continuation = (mtapi_uint_t)head;
+  } while (!embb_atomic_compare_and_swap_int(
+    list, &head, (int)continuation->handle.id));
+
+  return MTAPI_TRUE;
+}
+
+/* a continuation that could not be scheduled will never run, so it fails
+   right away and passes the failure on to its group and continuations */
+static void embb_mtapi_task_fail_continuation(
+  embb_mtapi_node_t* node,
+  embb_mtapi_task_t* task) {
+  /* no handle was returned for a detached task outside of a group, so
+     nobody else will delete it */
+  mtapi_boolean_t orphan = (task->attributes.is_detached &&
+    !embb_mtapi_group_pool_is_handle_valid(node->group_pool, task->group)) ?
+    MTAPI_TRUE : MTAPI_FALSE;
+  mtapi_action_hndl_t no_action = task->action;
+
+  if (embb_mtapi_queue_pool_is_handle_valid(node->queue_pool, task->queue)) {
+    embb_mtapi_queue_task_finished(
+      embb_mtapi_queue_pool_get_storage_for_handle(
+        node->queue_pool, task->queue));
+  }
+
+  if (embb_mtapi_task_try_change_state(
+    task, MTAPI_TASK_SCHEDULED, MTAPI_TASK_RUNNING) ||
+    embb_mtapi_task_try_change_state(
+    task, MTAPI_TASK_RETAINED, MTAPI_TASK_RUNNING)) {
+    task->error_code = MTAPI_ERR_TASK_LIMIT;
+  }
+  /* the scheduler has discounted the task for its action already */
+  no_action.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
+  embb_mtapi_task_finish_for_action(task, node, MTAPI_TASK_ERROR, no_action);
+
+  if (orphan) {
+    embb_mtapi_task_delete(task, node->task_pool);
+  }
+}
+
+void embb_mtapi_task_start_continuations(
+  embb_mtapi_node_t* node,
+  int first) {
+  int id = first;
+
+  assert(MTAPI_NULL != node);
+
+  /* ids start at 1, so both an empty and a closed list end the loop */
+  while (0 < id) {
+    embb_mtapi_task_t* task = embb_mtapi_task_pool_get_storage_for_id(
+      node->task_pool, (mtapi_uint_t)id);
+    /* the task may be done and gone once it is scheduled */
+    id = (int)task->next_continuation;
+    if (!embb_mtapi_scheduler_schedule_task(node->scheduler, task)) {
+      embb_mtapi_task_fail_continuation(node, task);
+    }
+  }
+}
+
+mtapi_boolean_t embb_mtapi_task_release_copy(
+  embb_mtapi_task_t* that,
+  embb_mtapi_node_t* node) {
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+
+  if (1 == embb_atomic_fetch_and_add_int(&that->pending_copies, -1)) {
+    /* last copy is done, complete the task */
+    embb_mtapi_task_finish(that, node,
+      (MTAPI_ERR_ACTION_DELETED == that->error_code) ?
+        MTAPI_TASK_ERROR : MTAPI_TASK_COMPLETED);
+    return MTAPI_TRUE;
+  }
+  return MTAPI_FALSE;
+}
+
+/* runs instances of a multi-instance task until all of them are claimed,
+   the instance number of the context is the first one to run. the task
+   stays running until the last copy is released. */
+static mtapi_boolean_t embb_mtapi_task_execute_instances(
+  embb_mtapi_task_t* that,
+  embb_mtapi_task_context_t * context) {
+  embb_mtapi_node_t* node = context->thread_context->node;
+
+  /* the first copy to arrive starts the task */
+  embb_mtapi_task_try_change_state(
+    that, MTAPI_TASK_SCHEDULED, MTAPI_TASK_RUNNING);
+
+  if (embb_mtapi_action_pool_is_handle_valid(
+    node->action_pool, that->action)) {
+    embb_mtapi_action_t* local_action =
+      embb_mtapi_action_pool_get_storage_for_handle(
+      node->action_pool, that->action);
+    /* the result buffer holds one result per instance */
+    while (context->instance_num < context->num_instances &&
+      MTAPI_TASK_RUNNING == embb_mtapi_task_get_state(that)) {
+      local_action->action_function(
+        that->arguments,
+        that->arguments_size,
+        (MTAPI_NULL == that->result_buffer) ? MTAPI_NULL :
+          (char*)that->result_buffer +
+            context->instance_num * that->result_size,
+        that->result_size,
+        local_action->node_local_data,
+        local_action->node_local_data_size,
+        context);
+      context->instance_num = embb_atomic_fetch_and_add_unsigned_int(
+        &that->current_instance, 1);
+    }
+  } else {
+    that->error_code = MTAPI_ERR_ACTION_DELETED;
+  }
+
+  return embb_mtapi_task_release_copy(that, node);
+}
+
+mtapi_boolean_t embb_mtapi_task_execute(
   embb_mtapi_task_t* that,
   embb_mtapi_task_context_t * context) {
   assert(MTAPI_NULL != that);
   assert(MTAPI_NULL != context);
 
-  embb_mtapi_task_set_state(that, MTAPI_TASK_RUNNING);
+  if (1 < that->attributes.num_instances) {
+    return embb_mtapi_task_execute_instances(that, context);
+  }
+
+  if (!embb_mtapi_task_try_change_state(
+    that, MTAPI_TASK_SCHEDULED, MTAPI_TASK_RUNNING)) {
+    /* task was cancelled after it was fetched, do not run it */
+    embb_mtapi_task_finish(
+      that, context->thread_context->node, MTAPI_TASK_CANCELLED);
+    return MTAPI_TRUE;
+  }
 
   /* is the associated action valid? */
   if (embb_mtapi_action_pool_is_handle_valid(
@@ -110,6 +322,15 @@ void embb_mtapi_task_execute(
     embb_mtapi_action_t* local_action =
       embb_mtapi_action_pool_get_storage_for_handle(
       context->thread_context->node->action_pool, that->action);
+    embb_mtapi_job_t* local_job = embb_mtapi_job_get_storage_for_id(
+      context->thread_context->node, that->job.id);
+    /* only measure if there is a choice between actions */
+    mtapi_boolean_t measure = (1 < local_job->num_actions) ?
+      MTAPI_TRUE : MTAPI_FALSE;
+    embb_time_t start;
+    if (measure) {
+      embb_time_now(&start);
+    }
     local_action->action_function(
       that->arguments,
       that->arguments_size,
@@ -118,24 +339,24 @@ void embb_mtapi_task_execute(
       local_action->node_local_data,
       local_action->node_local_data_size,
       context);
-    embb_atomic_memory_barrier();
+    if (measure) {
+      embb_time_t end;
+      embb_time_now(&end);
+      embb_mtapi_action_add_execution_time(local_action,
+        (unsigned long long)(end.seconds - start.seconds) * 1000000000ULL +
+        end.nanoseconds - start.nanoseconds);
+    }
     /* task has completed successfully */
-    embb_mtapi_task_set_state(that, MTAPI_TASK_COMPLETED);
-    embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
+    embb_mtapi_task_finish(
+      that, context->thread_context->node, MTAPI_TASK_COMPLETED);
   } else {
     /* action was deleted, task did not complete */
     that->error_code = MTAPI_ERR_ACTION_DELETED;
-    embb_mtapi_task_set_state(that, MTAPI_TASK_ERROR);
+    embb_mtapi_task_finish(
+      that, context->thread_context->node, MTAPI_TASK_ERROR);
   }
 
-  /* is task associated with a group? */
-  if (embb_mtapi_group_pool_is_handle_valid(
-    context->thread_context->node->group_pool, that->group)) {
-    embb_mtapi_group_t* local_group =
-      embb_mtapi_group_pool_get_storage_for_handle(
-      context->thread_context->node->group_pool, that->group);
-    embb_mtapi_task_queue_push(&local_group->queue, that);
-  }
+  return MTAPI_TRUE;
 }
 
 void embb_mtapi_task_set_state(
@@ -143,10 +364,83 @@ void embb_mtapi_task_set_state(
   mtapi_task_state_t state) {
   assert(MTAPI_NULL != that);
 
-  embb_mtapi_spinlock_acquire(&that->state_lock);
-  that->state = state;
-  embb_atomic_memory_barrier();
-  embb_mtapi_spinlock_release(&that->state_lock);
+  embb_atomic_store_int(&that->state, (int)state);
+
+  if (MTAPI_TASK_COMPLETED == state ||
+    MTAPI_TASK_ERROR == state ||
+    MTAPI_TASK_CANCELLED == state) {
+    embb_mtapi_task_notify_waiters(that);
+  }
+}
+
+mtapi_task_state_t embb_mtapi_task_get_state(
+  embb_mtapi_task_t* that) {
+  int state;
+
+  assert(MTAPI_NULL != that);
+
+  state = embb_atomic_load_int(&that->state);
+  if (EMBB_MTAPI_TASK_CANCELLING == state ||
+    EMBB_MTAPI_TASK_CANCEL_PENDING == state) {
+    state = MTAPI_TASK_CANCELLED;
+  }
+  return (mtapi_task_state_t)state;
+}
+
+mtapi_boolean_t embb_mtapi_task_try_change_state(
+  embb_mtapi_task_t* that,
+  mtapi_task_state_t expected,
+  mtapi_task_state_t desired) {
+  int expected_state = (int)expected;
+
+  assert(MTAPI_NULL != that);
+
+  return embb_atomic_compare_and_swap_int(
+    &that->state, &expected_state, (int)desired) ? MTAPI_TRUE : MTAPI_FALSE;
+}
+
+mtapi_boolean_t embb_mtapi_task_try_cancel(
+  embb_mtapi_task_t* that,
+  mtapi_status_t error_code) {
+  int state;
+
+  assert(MTAPI_NULL != that);
+
+  state = embb_atomic_load_int(&that->state);
+  for (;;) {
+    switch (state) {
+    case MTAPI_TASK_COMPLETED:
+    case MTAPI_TASK_CANCELLED:
+    case MTAPI_TASK_ERROR:
+    case MTAPI_TASK_DELETED:
+    case EMBB_MTAPI_TASK_CANCELLING:
+    case EMBB_MTAPI_TASK_CANCEL_PENDING:
+      /* task has already finished or is being cancelled */
+      return MTAPI_FALSE;
+
+    default:
+      /* state is updated if the compare and swap fails. the task is
+         claimed first, so waiters find the error code once it is
+         cancelled. */
+      if (embb_atomic_compare_and_swap_int(
+        &that->state, &state, EMBB_MTAPI_TASK_CANCELLING)) {
+        that->error_code = error_code;
+        if (MTAPI_TASK_SCHEDULED == state ||
+          MTAPI_TASK_RETAINED == state ||
+          MTAPI_TASK_RUNNING == state) {
+          /* a worker or a queue still holds the task, and a running action
+             may still write its result. waiters are released once the task
+             is finished. */
+          embb_atomic_store_int(&that->state, EMBB_MTAPI_TASK_CANCEL_PENDING);
+        } else {
+          embb_atomic_store_int(&that->state, MTAPI_TASK_CANCELLED);
+          embb_mtapi_task_notify_waiters(that);
+        }
+        return MTAPI_TRUE;
+      }
+      break;
+    }
+  }
 }
 
 static mtapi_task_hndl_t embb_mtapi_task_start(
@@ -159,6 +453,7 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
   MTAPI_IN mtapi_task_attributes_t* attributes,
   MTAPI_IN mtapi_group_hndl_t group,
   MTAPI_IN mtapi_queue_hndl_t queue,
+  MTAPI_INOUT embb_atomic_int* continuation_list,
   MTAPI_OUT mtapi_status_t* status) {
   mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
   mtapi_task_hndl_t task_hndl = { 0, EMBB_MTAPI_IDPOOL_INVALID_ID };
@@ -172,7 +467,8 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
         embb_mtapi_job_get_storage_for_id(node, job.id);
       embb_mtapi_task_t* task = embb_mtapi_task_pool_allocate(node->task_pool);
       if (MTAPI_NULL != task) {
-        mtapi_uint_t action_index;
+        mtapi_action_hndl_t action;
+        mtapi_task_state_t scheduled_state = MTAPI_TASK_SCHEDULED;
 
         embb_mtapi_task_initialize(task);
         embb_mtapi_task_set_state(task, MTAPI_TASK_PRENATAL);
@@ -189,12 +485,24 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
           mtapi_taskattr_init(&task->attributes, &local_status);
         }
 
+        if (MTAPI_NULL == result_buffer && 0 < result_size) {
+          /* small results without a buffer are kept by the task itself,
+             one result per instance */
+          mtapi_uint_t num_instances = (1 < task->attributes.num_instances) ?
+            task->attributes.num_instances : 1;
+          if (MTAPI_TASK_RESULT_INLINE_SIZE / result_size >= num_instances) {
+            memset(task->result_storage.bytes, 0,
+              result_size * num_instances);
+            task->result_buffer = task->result_storage.bytes;
+          }
+        }
+
         if (embb_mtapi_group_pool_is_handle_valid(node->group_pool, group)) {
           embb_mtapi_group_t* local_group =
             embb_mtapi_group_pool_get_storage_for_handle(
             node->group_pool, group);
           task->group = group;
-          embb_atomic_fetch_and_add_int(&local_group->num_tasks, 1);
+          embb_mtapi_group_task_started(local_group, 1);
         } else {
           task->group.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
         }
@@ -205,16 +513,20 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
             node->queue_pool, queue);
           task->queue = queue;
           embb_mtapi_queue_task_started(local_queue);
+          /* a disabled queue only takes tasks if it retains them until it
+             is enabled again */
+          if (MTAPI_FALSE == embb_atomic_load_char(&local_queue->enabled)) {
+            scheduled_state = MTAPI_TASK_RETAINED;
+          }
         } else {
           task->queue.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
         }
 
-        /* load balancing is unsupported right now,
-           so always choose action 0 */
-        action_index = 0;
+        /* balance the load between the actions of the job */
+        action = embb_mtapi_job_select_action(local_job, node);
         if (embb_mtapi_action_pool_is_handle_valid(
-          node->action_pool, local_job->actions[action_index])) {
-          task->action = local_job->actions[action_index];
+          node->action_pool, action)) {
+          task->action = action;
           embb_mtapi_task_set_state(task, MTAPI_TASK_CREATED);
           task_hndl = task->handle;
           local_status = MTAPI_SUCCESS;
@@ -231,10 +543,17 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
           embb_mtapi_scheduler_t * scheduler = node->scheduler;
           mtapi_boolean_t was_scheduled;
 
-          embb_mtapi_task_set_state(task, MTAPI_TASK_SCHEDULED);
+          embb_mtapi_task_set_state(task, scheduled_state);
 
-          was_scheduled =
-            embb_mtapi_scheduler_schedule_task(scheduler, task);
+          /* a continuation waits in the list of its predecessor, unless the
+             predecessor is done already */
+          if (MTAPI_NULL != continuation_list &&
+            embb_mtapi_task_add_continuation(continuation_list, task)) {
+            was_scheduled = MTAPI_TRUE;
+          } else {
+            was_scheduled =
+              embb_mtapi_scheduler_schedule_task(scheduler, task);
+          }
 
           if (was_scheduled) {
             /* if task is detached, do not return a handle, it will be deleted
@@ -252,6 +571,15 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
         }
 
         if (MTAPI_SUCCESS != local_status) {
+          /* the group does not have to wait for the task */
+          if (embb_mtapi_group_pool_is_handle_valid(
+            node->group_pool, task->group)) {
+            embb_mtapi_group_t* local_group =
+              embb_mtapi_group_pool_get_storage_for_handle(
+              node->group_pool, task->group);
+            embb_mtapi_group_task_started(local_group, -1);
+            embb_mtapi_group_check_continuations(local_group, node);
+          }
           embb_mtapi_task_delete(task, node->task_pool);
           task_hndl.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
         }
@@ -269,6 +597,35 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
   return task_hndl;
 }
 
+mtapi_task_hndl_t embb_mtapi_task_start_continuation(
+  MTAPI_INOUT embb_atomic_int* list,
+  MTAPI_IN mtapi_task_id_t task_id,
+  MTAPI_IN mtapi_job_hndl_t job,
+  MTAPI_IN void* arguments,
+  MTAPI_IN mtapi_size_t arguments_size,
+  MTAPI_OUT void* result_buffer,
+  MTAPI_IN mtapi_size_t result_size,
+  MTAPI_IN mtapi_task_attributes_t* attributes,
+  MTAPI_IN mtapi_group_hndl_t group,
+  MTAPI_OUT mtapi_status_t* status) {
+  mtapi_queue_hndl_t queue_hndl = { 0, EMBB_MTAPI_IDPOOL_INVALID_ID };
+
+  assert(MTAPI_NULL != list);
+
+  return embb_mtapi_task_start(
+    task_id,
+    job,
+    arguments,
+    arguments_size,
+    result_buffer,
+    result_size,
+    attributes,
+    group,
+    queue_hndl,
+    list,
+    status);
+}
+
 
 /* ---- INTERFACE FUNCTIONS ------------------------------------------------ */
 
@@ -296,9 +653,198 @@ mtapi_task_hndl_t mtapi_task_start(
     attributes,
     group,
     queue_hndl,
+    MTAPI_NULL,
     status);
 }
 
+mtapi_task_hndl_t mtapi_task_continue_with(
+  MTAPI_IN mtapi_task_hndl_t predecessor,
+  MTAPI_IN mtapi_task_id_t task_id,
+  MTAPI_IN mtapi_job_hndl_t job,
+  MTAPI_IN void* arguments,
+  MTAPI_IN mtapi_size_t arguments_size,
+  MTAPI_OUT void* result_buffer, /* pointer to result buffer */
+  MTAPI_IN mtapi_size_t result_size,   /* size of one result */
+  MTAPI_IN mtapi_task_attributes_t* attributes,
+  MTAPI_IN mtapi_group_hndl_t group,
+  MTAPI_OUT mtapi_status_t* status) {
+  mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_hndl_t task_hndl = { 0, EMBB_MTAPI_IDPOOL_INVALID_ID };
+
+  embb_mtapi_log_trace("mtapi_task_continue_with() called\n");
+
+  if (embb_mtapi_node_is_initialized()) {
+    embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+    if (embb_mtapi_task_pool_is_handle_valid(node->task_pool, predecessor)) {
+      embb_mtapi_task_t* local_task =
+        embb_mtapi_task_pool_get_storage_for_handle(
+          node->task_pool, predecessor);
+      task_hndl = embb_mtapi_task_start_continuation(
+        &local_task->continuations,
+        task_id,
+        job,
+        arguments,
+        arguments_size,
+        result_buffer,
+        result_size,
+        attributes,
+        group,
+        &local_status);
+    } else {
+      local_status = MTAPI_ERR_TASK_INVALID;
+    }
+  } else {
+    embb_mtapi_log_error("mtapi not initialized\n");
+    local_status = MTAPI_ERR_NODE_NOTINIT;
+  }
+
+  mtapi_status_set(status, local_status);
+  return task_hndl;
+}
+
+mtapi_uint_t mtapi_task_start_batch(
+  MTAPI_IN mtapi_job_hndl_t job,
+  MTAPI_IN void* arguments,
+  MTAPI_IN mtapi_size_t arguments_size,
+  MTAPI_OUT void* result_buffer,
+  MTAPI_IN mtapi_size_t result_size,
+  MTAPI_IN mtapi_task_attributes_t* attributes,
+  MTAPI_IN mtapi_group_hndl_t group,
+  MTAPI_IN mtapi_uint_t count,
+  MTAPI_OUT mtapi_task_hndl_t* tasks,
+  MTAPI_OUT mtapi_status_t* status) {
+  mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_hndl_t invalid_hndl = { 0, EMBB_MTAPI_IDPOOL_INVALID_ID };
+  mtapi_uint_t started = 0;
+  mtapi_uint_t ii;
+
+  embb_mtapi_log_trace("mtapi_task_start_batch() called\n");
+
+  if (MTAPI_NULL != tasks) {
+    for (ii = 0; ii < count; ii++) {
+      tasks[ii] = invalid_hndl;
+    }
+  }
+
+  if (embb_mtapi_node_is_initialized()) {
+    embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+    if (embb_mtapi_job_is_handle_valid(node, job)) {
+      embb_mtapi_job_t* local_job =
+        embb_mtapi_job_get_storage_for_id(node, job.id);
+      mtapi_action_hndl_t action =
+        embb_mtapi_job_select_action(local_job, node);
+      embb_mtapi_group_t* local_group = MTAPI_NULL;
+      mtapi_task_attributes_t local_attributes;
+
+      /* everything the tasks have in common is checked once */
+      if (MTAPI_NULL != attributes) {
+        local_attributes = *attributes;
+        local_status = MTAPI_SUCCESS;
+      } else {
+        mtapi_taskattr_init(&local_attributes, &local_status);
+      }
+      if (!embb_mtapi_action_pool_is_handle_valid(node->action_pool, action)) {
+        local_status = MTAPI_ERR_ACTION_INVALID;
+      } else if (node->attributes.max_priorities <=
+        local_attributes.priority) {
+        local_status = MTAPI_ERR_PARAMETER;
+      }
+      if (embb_mtapi_group_pool_is_handle_valid(node->group_pool, group)) {
+        local_group =
+          embb_mtapi_group_pool_get_storage_for_handle(node->group_pool, group);
+      }
+
+      while (MTAPI_SUCCESS == local_status && started < count) {
+        embb_mtapi_task_t* chunk[EMBB_MTAPI_TASK_BATCH_CHUNK];
+        mtapi_uint_t chunk_size = count - started;
+        mtapi_uint_t allocated;
+        mtapi_uint_t scheduled;
+
+        if (chunk_size > EMBB_MTAPI_TASK_BATCH_CHUNK) {
+          chunk_size = EMBB_MTAPI_TASK_BATCH_CHUNK;
+        }
+
+        /* a chunk shares one action, the load is balanced per chunk */
+        if (0 < started) {
+          action = embb_mtapi_job_select_action(local_job, node);
+          if (!embb_mtapi_action_pool_is_handle_valid(
+            node->action_pool, action)) {
+            local_status = MTAPI_ERR_ACTION_INVALID;
+            break;
+          }
+        }
+
+        for (allocated = 0; allocated < chunk_size; allocated++) {
+          mtapi_uint_t index = started + allocated;
+          embb_mtapi_task_t* task =
+            embb_mtapi_task_pool_allocate(node->task_pool);
+          if (MTAPI_NULL == task) {
+            break;
+          }
+          embb_mtapi_task_initialize(task);
+          task->job = job;
+          task->action = action;
+          task->attributes = local_attributes;
+          task->arguments = (MTAPI_NULL == arguments) ? MTAPI_NULL :
+            (char*)arguments + index * arguments_size;
+          task->arguments_size = arguments_size;
+          /* each task has one result per instance */
+          task->result_buffer = (MTAPI_NULL == result_buffer) ? MTAPI_NULL :
+            (char*)result_buffer +
+              index * local_attributes.num_instances * result_size;
+          task->result_size = result_size;
+          if (MTAPI_NULL != local_group) {
+            task->group = group;
+          }
+          embb_mtapi_task_set_state(task, MTAPI_TASK_SCHEDULED);
+          /* detached tasks do not return a handle */
+          if (MTAPI_NULL != tasks && !local_attributes.is_detached) {
+            tasks[index] = task->handle;
+          }
+          chunk[allocated] = task;
+        }
+        if (0 == allocated) {
+          local_status = MTAPI_ERR_TASK_LIMIT;
+          break;
+        }
+
+        if (MTAPI_NULL != local_group) {
+          embb_mtapi_group_task_started(local_group, (int)allocated);
+        }
+
+        scheduled = embb_mtapi_scheduler_schedule_tasks(
+          node->scheduler, chunk, allocated);
+
+        /* tasks that could not be pushed are dropped again */
+        for (ii = scheduled; ii < allocated; ii++) {
+          embb_mtapi_task_set_state(chunk[ii], MTAPI_TASK_ERROR);
+          embb_mtapi_task_delete(chunk[ii], node->task_pool);
+          if (MTAPI_NULL != tasks) {
+            tasks[started + ii] = invalid_hndl;
+          }
+        }
+        if (MTAPI_NULL != local_group && scheduled < allocated) {
+          embb_mtapi_group_task_started(
+            local_group, -(int)(allocated - scheduled));
+          embb_mtapi_group_check_continuations(local_group, node);
+        }
+
+        started += scheduled;
+        if (scheduled < chunk_size) {
+          local_status = MTAPI_ERR_TASK_LIMIT;
+        }
+      }
+    } else {
+      local_status = MTAPI_ERR_JOB_INVALID;
+    }
+  } else {
+    local_status = MTAPI_ERR_NODE_NOTINIT;
+  }
+
+  mtapi_status_set(status, local_status);
+  return started;
+}
+
 mtapi_task_hndl_t mtapi_task_enqueue(
   MTAPI_IN mtapi_task_id_t task_id,
   MTAPI_IN mtapi_queue_hndl_t queue,
@@ -339,6 +885,7 @@ mtapi_task_hndl_t mtapi_task_enqueue(
           &local_attributes,
           group,
           queue,
+          MTAPI_NULL,
           &local_status);
       } else {
         local_status = MTAPI_ERR_QUEUE_DISABLED;
@@ -439,6 +986,38 @@ void mtapi_task_wait(
   mtapi_status_set(status, local_status);
 }
 
+void* mtapi_task_get_result(
+  MTAPI_IN mtapi_task_hndl_t task,
+  MTAPI_IN mtapi_timeout_t timeout,
+  MTAPI_OUT mtapi_status_t* status) {
+  mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
+  void* result = MTAPI_NULL;
+
+  embb_mtapi_log_trace("mtapi_task_get_result() called\n");
+
+  if (embb_mtapi_node_is_initialized()) {
+    embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+    if (embb_mtapi_task_pool_is_handle_valid(node->task_pool, task)) {
+      embb_mtapi_task_t* local_task =
+        embb_mtapi_task_pool_get_storage_for_handle(node->task_pool, task);
+      if (embb_mtapi_scheduler_wait_for_task(local_task, timeout)) {
+        /* the task stays alive until it is released by mtapi_task_wait() */
+        local_status = local_task->error_code;
+        result = local_task->result_buffer;
+      } else {
+        local_status = MTAPI_TIMEOUT;
+      }
+    } else {
+      local_status = MTAPI_ERR_TASK_INVALID;
+    }
+  } else {
+    local_status = MTAPI_ERR_NODE_NOTINIT;
+  }
+
+  mtapi_status_set(status, local_status);
+  return result;
+}
+
 void mtapi_task_cancel(
   MTAPI_IN mtapi_task_hndl_t task,
   MTAPI_OUT mtapi_status_t* status) {
@@ -451,7 +1030,7 @@ void mtapi_task_cancel(
     if (embb_mtapi_task_pool_is_handle_valid(node->task_pool, task)) {
       embb_mtapi_task_t* local_task =
         embb_mtapi_task_pool_get_storage_for_handle(node->task_pool, task);
-      embb_mtapi_task_set_state(local_task, MTAPI_TASK_CANCELLED);
+      embb_mtapi_task_try_cancel(local_task, MTAPI_ERR_ACTION_CANCELLED);
       local_status = MTAPI_SUCCESS;
     } else {
       local_status = MTAPI_ERR_TASK_INVALID;
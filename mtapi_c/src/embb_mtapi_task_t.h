@@ -31,7 +31,6 @@
 #include <embb/base/c/atomic.h>
 
 #include <embb_mtapi_pool_template.h>
-#include <embb_mtapi_spinlock_t.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,6 +40,7 @@ extern "C" {
 /* ---- FORWARD DECLARATIONS ----------------------------------------------- */
 
 typedef struct embb_mtapi_task_context_struct embb_mtapi_task_context_t;
+typedef struct embb_mtapi_node_struct embb_mtapi_node_t;
 typedef struct embb_mtapi_task_pool_struct embb_mtapi_task_pool_t;
 
 
@@ -53,26 +53,63 @@ typedef struct embb_mtapi_task_pool_struct embb_mtapi_task_pool_t;
  * \ingroup INTERNAL
  */
 struct embb_mtapi_task_struct {
+  /* written while the task runs and read by waiting threads, kept together
+     at the start of the task so they share as few cache lines as possible */
   mtapi_task_hndl_t handle;
+  embb_atomic_int state;
+  embb_atomic_int num_waiters;
+  embb_atomic_unsigned_int current_instance;
+  embb_atomic_int pending_copies;
+  mtapi_status_t error_code;
 
+  /* written once when the task is started */
   mtapi_task_id_t task_id;
   mtapi_job_hndl_t job;
+  mtapi_action_hndl_t action;
   const void * arguments;
   mtapi_size_t arguments_size;
   void * result_buffer;
   mtapi_size_t result_size;
-  mtapi_task_attributes_t attributes;
   mtapi_group_hndl_t group;
   mtapi_queue_hndl_t queue;
+  mtapi_task_attributes_t attributes;
 
-  mtapi_action_hndl_t action;
-  embb_mtapi_spinlock_t state_lock;
-  volatile mtapi_task_state_t state;
-  embb_atomic_unsigned_int current_instance;
+  /* holds the result if the task was started without a result buffer */
+  union {
+    char bytes[MTAPI_TASK_RESULT_INLINE_SIZE];
+    double align_double;
+    long long align_long_long;
+    void * align_pointer;
+  } result_storage;
 
-  mtapi_status_t error_code;
+  /* id of the first task to start once this one is finished, closed by
+     EMBB_MTAPI_TASK_CONTINUATIONS_CLOSED when it is */
+  embb_atomic_int continuations;
+  /* id of the next task in the continuation list this task is waiting in */
+  mtapi_uint_t next_continuation;
 };
 
+/**
+ * Marks a continuation list that does not take any more tasks.
+ * \memberof embb_mtapi_task_struct
+ */
+#define EMBB_MTAPI_TASK_CONTINUATIONS_CLOSED (-1)
+
+/**
+ * Internal state of a task while it is being cancelled and its error code
+ * is written, reported as MTAPI_TASK_CANCELLED.
+ * \memberof embb_mtapi_task_struct
+ */
+#define EMBB_MTAPI_TASK_CANCELLING (MTAPI_TASK_COMPLETED + 1)
+
+/**
+ * Internal state of a task cancelled while it was scheduled, retained or
+ * running, reported as MTAPI_TASK_CANCELLED. It stays pending until the
+ * task is finished.
+ * \memberof embb_mtapi_task_struct
+ */
+#define EMBB_MTAPI_TASK_CANCEL_PENDING (MTAPI_TASK_COMPLETED + 2)
+
 /**
  * Task type.
  * \memberof embb_mtapi_task_struct
@@ -109,12 +146,83 @@ void embb_mtapi_task_finalize(embb_mtapi_task_t* that);
  * Execute the action function of a task within the given context. Notfies
  * the associated task group or queue if set. Deletes the task if it is
  * detached.
+ *
+ * A task with more than one instance is pushed to several worker queues.
+ * Each of these copies runs instances until none are left, the last copy
+ * to finish completes the task.
+ *
+ * \returns MTAPI_TRUE if the task is finished, MTAPI_FALSE if other copies
+ *          of a multi-instance task are still pending
  * \memberof embb_mtapi_task_struct
  */
-void embb_mtapi_task_execute(
+mtapi_boolean_t embb_mtapi_task_execute(
   embb_mtapi_task_t* that,
   embb_mtapi_task_context_t * context);
 
+/**
+ * Drops a copy of a multi-instance task that was not executed and completes
+ * the task if it was the last one.
+ *
+ * \returns MTAPI_TRUE if the task is finished
+ * \memberof embb_mtapi_task_struct
+ */
+mtapi_boolean_t embb_mtapi_task_release_copy(
+  embb_mtapi_task_t* that,
+  embb_mtapi_node_t* node);
+
+/**
+ * Publishes the final state of a task that was handed to a worker and
+ * notifies waiting threads, the action, the group and the continuations of
+ * the task. A task cancelled meanwhile stays cancelled.
+ *
+ * The task must not be touched afterwards, as a waiting thread may delete
+ * it as soon as it sees the final state.
+ *
+ * \memberof embb_mtapi_task_struct
+ */
+void embb_mtapi_task_finish(
+  embb_mtapi_task_t* that,
+  embb_mtapi_node_t* node,
+  mtapi_task_state_t state);
+
+/**
+ * Adds a task that has been set up, but not scheduled yet, to a
+ * continuation list.
+ *
+ * \returns MTAPI_FALSE if the list is closed, the task has to be started
+ *          right away then
+ * \memberof embb_mtapi_task_struct
+ */
+mtapi_boolean_t embb_mtapi_task_add_continuation(
+  embb_atomic_int* list,
+  embb_mtapi_task_t* continuation);
+
+/**
+ * Schedules the tasks of a continuation list, \a first is the head of the
+ * list taken from its owner.
+ * \memberof embb_mtapi_task_struct
+ */
+void embb_mtapi_task_start_continuations(
+  embb_mtapi_node_t* node,
+  int first);
+
+/**
+ * Starts a task that waits in the continuation list \a list, or is
+ * scheduled right away if the list is closed already.
+ * \memberof embb_mtapi_task_struct
+ */
+mtapi_task_hndl_t embb_mtapi_task_start_continuation(
+  MTAPI_INOUT embb_atomic_int* list,
+  MTAPI_IN mtapi_task_id_t task_id,
+  MTAPI_IN mtapi_job_hndl_t job,
+  MTAPI_IN void* arguments,
+  MTAPI_IN mtapi_size_t arguments_size,
+  MTAPI_OUT void* result_buffer,
+  MTAPI_IN mtapi_size_t result_size,
+  MTAPI_IN mtapi_task_attributes_t* attributes,
+  MTAPI_IN mtapi_group_hndl_t group,
+  MTAPI_OUT mtapi_status_t* status);
+
 /**
  * Set the current task state.
  * \memberof embb_mtapi_task_struct
@@ -123,6 +231,36 @@ void embb_mtapi_task_set_state(
   embb_mtapi_task_t* that,
   mtapi_task_state_t state);
 
+/**
+ * Get the current task state, a task being cancelled or waiting to be
+ * finished after it was cancelled is reported as cancelled.
+ * \memberof embb_mtapi_task_struct
+ */
+mtapi_task_state_t embb_mtapi_task_get_state(
+  embb_mtapi_task_t* that);
+
+/**
+ * Change the task state to \c desired if it currently is \c expected.
+ * Returns MTAPI_TRUE if the state was changed.
+ * \memberof embb_mtapi_task_struct
+ */
+mtapi_boolean_t embb_mtapi_task_try_change_state(
+  embb_mtapi_task_t* that,
+  mtapi_task_state_t expected,
+  mtapi_task_state_t desired);
+
+/**
+ * Set the task state to cancelled, unless the task has already finished.
+ * The error code is in place before waiting threads see the new state.
+ * A task that is scheduled, retained or running is finished by whoever
+ * holds it, waiting threads are released only then.
+ * Returns MTAPI_TRUE if the task was cancelled.
+ * \memberof embb_mtapi_task_struct
+ */
+mtapi_boolean_t embb_mtapi_task_try_cancel(
+  embb_mtapi_task_t* that,
+  mtapi_status_t error_code);
+
 
 /* ---- POOL DECLARATION --------------------------------------------------- */
 
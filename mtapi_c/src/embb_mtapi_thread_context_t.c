@@ -27,13 +27,21 @@
 #include <assert.h>
 
 #include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/internal/platform.h>
 
 #include <embb_mtapi_log.h>
 #include <embb_mtapi_alloc.h>
 #include <embb_mtapi_task_queue_t.h>
+#include <embb_mtapi_task_deque_t.h>
 #include <embb_mtapi_scheduler_t.h>
 #include <embb_mtapi_node_t.h>
 #include <embb_mtapi_thread_context_t.h>
+#include <embb_mtapi_topology.h>
+
+
+/* context of the worker running on the current thread, NULL otherwise */
+EMBB_THREAD_SPECIFIC embb_mtapi_thread_context_t *
+  embb_mtapi_thread_context_current = NULL;
 
 
 /* ---- CLASS MEMBERS ------------------------------------------------------ */
@@ -43,33 +51,61 @@ void embb_mtapi_thread_context_initialize_with_node_worker_and_core(
   embb_mtapi_node_t* node,
   mtapi_uint_t worker_index,
   mtapi_uint_t core_num) {
-  mtapi_uint_t ii;
-
   assert(MTAPI_NULL != that);
   assert(MTAPI_NULL != node);
 
   that->node = node;
   that->worker_index = worker_index;
   that->core_num = core_num;
+  that->numa_domain = embb_mtapi_topology_get_numa_domain(core_num);
+  that->victims = MTAPI_NULL;
+  that->local_victim_count = 0;
+  /* xorshift state must not be zero, spread seeds across workers */
+  that->random_state = (mtapi_uint32_t)(worker_index + 1) * 2654435761u;
   that->priorities = node->attributes.max_priorities;
   embb_atomic_store_int(&that->run, 0);
+  embb_atomic_store_int(&that->is_sleeping, 0);
+  /* queues are allocated by the worker thread */
+  that->deque = MTAPI_NULL;
+  that->queue = MTAPI_NULL;
+  that->private_queue = MTAPI_NULL;
+
+  embb_mutex_init(&that->work_available_mutex, EMBB_MUTEX_PLAIN);
+  embb_condition_init(&that->work_available);
+}
+
+void embb_mtapi_thread_context_initialize_queues(
+  embb_mtapi_thread_context_t* that) {
+  embb_mtapi_node_t* node;
+  mtapi_uint_t ii;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != that->node);
+
+  node = that->node;
+  that->deque = (embb_mtapi_task_deque_t**)embb_mtapi_alloc_allocate(
+    sizeof(embb_mtapi_task_deque_t*)*that->priorities);
   that->queue = (embb_mtapi_task_queue_t**)embb_mtapi_alloc_allocate(
     sizeof(embb_mtapi_task_queue_t)*that->priorities);
   that->private_queue = (embb_mtapi_task_queue_t**)embb_mtapi_alloc_allocate(
     sizeof(embb_mtapi_task_queue_t)*that->priorities);
   for (ii = 0; ii < that->priorities; ii++) {
+    that->deque[ii] = (embb_mtapi_task_deque_t*)
+      embb_mtapi_alloc_allocate_cache_aligned(
+        sizeof(embb_mtapi_task_deque_t));
+    embb_mtapi_task_deque_initialize_with_capacity(
+      that->deque[ii], node->attributes.queue_limit);
     that->queue[ii] = (embb_mtapi_task_queue_t*)
-      embb_mtapi_alloc_allocate(sizeof(embb_mtapi_task_queue_t));
+      embb_mtapi_alloc_allocate_cache_aligned(
+        sizeof(embb_mtapi_task_queue_t));
     embb_mtapi_task_queue_initialize_with_capacity(
       that->queue[ii], node->attributes.queue_limit);
     that->private_queue[ii] = (embb_mtapi_task_queue_t*)
-      embb_mtapi_alloc_allocate(sizeof(embb_mtapi_task_queue_t));
+      embb_mtapi_alloc_allocate_cache_aligned(
+        sizeof(embb_mtapi_task_queue_t));
     embb_mtapi_task_queue_initialize_with_capacity(
       that->private_queue[ii], node->attributes.queue_limit);
   }
-
-  embb_mutex_init(&that->work_available_mutex, EMBB_MUTEX_PLAIN);
-  embb_condition_init(&that->work_available);
 }
 
 mtapi_boolean_t embb_mtapi_thread_context_start(
@@ -113,7 +149,10 @@ void embb_mtapi_thread_context_stop(embb_mtapi_thread_context_t* that) {
   int result;
   if (0 < embb_atomic_load_int(&that->run)) {
     embb_atomic_store_int(&that->run, 0);
+    /* notify under the mutex, so a worker about to park cannot miss it */
+    embb_mutex_lock(&that->work_available_mutex);
     embb_condition_notify_one(&that->work_available);
+    embb_mutex_unlock(&that->work_available_mutex);
     embb_thread_join(&(that->thread), &result);
   }
 }
@@ -128,14 +167,19 @@ void embb_mtapi_thread_context_finalize(embb_mtapi_thread_context_t* that) {
   embb_condition_destroy(&that->work_available);
   embb_mutex_destroy(&that->work_available_mutex);
 
-  for (ii = 0; ii < that->priorities; ii++) {
+  for (ii = 0; MTAPI_NULL != that->deque && ii < that->priorities; ii++) {
+    embb_mtapi_task_deque_finalize(that->deque[ii]);
+    embb_mtapi_alloc_deallocate_cache_aligned(that->deque[ii]);
+    that->deque[ii] = MTAPI_NULL;
     embb_mtapi_task_queue_finalize(that->queue[ii]);
-    embb_mtapi_alloc_deallocate(that->queue[ii]);
+    embb_mtapi_alloc_deallocate_cache_aligned(that->queue[ii]);
     that->queue[ii] = MTAPI_NULL;
     embb_mtapi_task_queue_finalize(that->private_queue[ii]);
-    embb_mtapi_alloc_deallocate(that->private_queue[ii]);
+    embb_mtapi_alloc_deallocate_cache_aligned(that->private_queue[ii]);
     that->private_queue[ii] = MTAPI_NULL;
   }
+  embb_mtapi_alloc_deallocate(that->deque);
+  that->deque = MTAPI_NULL;
   embb_mtapi_alloc_deallocate(that->queue);
   that->queue = MTAPI_NULL;
   embb_mtapi_alloc_deallocate(that->private_queue);
@@ -155,7 +199,7 @@ mtapi_boolean_t embb_mtapi_thread_context_process_tasks(
   assert(MTAPI_NULL != that);
   assert(MTAPI_NULL != process);
 
-  for (ii = 0; ii < that->priorities; ii++) {
+  for (ii = 0; MTAPI_NULL != that->deque && ii < that->priorities; ii++) {
     result = embb_mtapi_task_queue_process(
       that->private_queue[ii], process, user_data);
     if (MTAPI_FALSE == result) {
@@ -170,3 +214,29 @@ mtapi_boolean_t embb_mtapi_thread_context_process_tasks(
 
   return result;
 }
+
+mtapi_boolean_t embb_mtapi_thread_context_wakeup(
+  embb_mtapi_thread_context_t* that) {
+  int expected = 1;
+
+  assert(MTAPI_NULL != that);
+
+  /* only one caller may take the worker out of the sleeping state */
+  if (embb_atomic_compare_and_swap_int(&that->is_sleeping, &expected, 0)) {
+    /* the worker holds the mutex until it is waiting on the condition,
+       so the notification cannot get lost */
+    embb_mutex_lock(&that->work_available_mutex);
+    embb_condition_notify_one(&that->work_available);
+    embb_mutex_unlock(&that->work_available_mutex);
+    return MTAPI_TRUE;
+  }
+  return MTAPI_FALSE;
+}
+
+embb_mtapi_thread_context_t * embb_mtapi_thread_context_get_current() {
+  return embb_mtapi_thread_context_current;
+}
+
+void embb_mtapi_thread_context_set_current(embb_mtapi_thread_context_t* that) {
+  embb_mtapi_thread_context_current = that;
+}
@@ -40,6 +40,7 @@ extern "C" {
 /* ---- FORWARD DECLARATIONS ----------------------------------------------- */
 
 typedef struct embb_mtapi_task_queue_struct embb_mtapi_task_queue_t;
+typedef struct embb_mtapi_task_deque_struct embb_mtapi_task_deque_t;
 typedef struct embb_mtapi_node_struct embb_mtapi_node_t;
 typedef struct embb_mtapi_scheduler_struct embb_mtapi_scheduler_t;
 
@@ -52,20 +53,36 @@ typedef struct embb_mtapi_scheduler_struct embb_mtapi_scheduler_t;
  * \ingroup INTERNAL
  */
 struct embb_mtapi_thread_context_struct {
-  embb_mutex_t work_available_mutex;
-  embb_condition_t work_available;
-  embb_thread_t thread;
-  embb_tss_t tss_id;
+  /* contexts are stored in an array, keep the fields of neighbouring
+     workers on separate cache lines */
+  char padding_front[EMBB_CACHE_LINE_SIZE];
 
+  /* read mostly, also read by other workers looking for work */
   embb_mtapi_node_t* node;
+  embb_mtapi_task_deque_t** deque;
   embb_mtapi_task_queue_t** queue;
   embb_mtapi_task_queue_t** private_queue;
-
   mtapi_uint_t priorities;
   mtapi_uint_t worker_index;
   mtapi_uint_t core_num;
-  embb_atomic_int run;
+  mtapi_uint_t numa_domain;
+  /* other workers in stealing order, the first local_victim_count ones
+     share the NUMA domain of this worker */
+  mtapi_uint_t* victims;
+  mtapi_uint_t local_victim_count;
+  embb_thread_t thread;
   mtapi_status_t status;
+
+  char padding_read_mostly[EMBB_CACHE_LINE_SIZE];
+
+  /* written by the worker and by threads waking it up */
+  embb_mutex_t work_available_mutex;
+  embb_condition_t work_available;
+  embb_atomic_int run;
+  embb_atomic_int is_sleeping;
+  mtapi_uint32_t random_state;
+
+  char padding_back[EMBB_CACHE_LINE_SIZE];
 };
 
 /**
@@ -84,6 +101,15 @@ void embb_mtapi_thread_context_initialize_with_node_worker_and_core(
   mtapi_uint_t worker_index,
   mtapi_uint_t core_num);
 
+/**
+ * Allocates the task queues of the context. To be called by the worker
+ * thread itself, so the queues are placed on the memory of its NUMA domain
+ * by first touch.
+ * \memberof embb_mtapi_thread_context_struct
+ */
+void embb_mtapi_thread_context_initialize_queues(
+  embb_mtapi_thread_context_t* that);
+
 /**
  * Destructor.
  * \memberof embb_mtapi_thread_context_struct
@@ -106,7 +132,32 @@ mtapi_boolean_t embb_mtapi_thread_context_start(
 void embb_mtapi_thread_context_stop(embb_mtapi_thread_context_t* that);
 
 /**
- * Apply visitor function to all tasks in the queues of the context.
+ * Wakes up the worker if it is sleeping. Returns MTAPI_TRUE if the worker was
+ * sleeping and this call took it out of the sleeping state, MTAPI_FALSE
+ * otherwise.
+ * \memberof embb_mtapi_thread_context_struct
+ */
+mtapi_boolean_t embb_mtapi_thread_context_wakeup(
+  embb_mtapi_thread_context_t* that);
+
+/**
+ * Returns the thread context of the calling worker thread or NULL if not
+ * called from a worker thread.
+ * \memberof embb_mtapi_thread_context_struct
+ */
+embb_mtapi_thread_context_t * embb_mtapi_thread_context_get_current();
+
+/**
+ * Associates the calling thread with the given thread context, pass NULL
+ * to remove the association. To be called by the worker thread itself.
+ * \memberof embb_mtapi_thread_context_struct
+ */
+void embb_mtapi_thread_context_set_current(embb_mtapi_thread_context_t* that);
+
+/**
+ * Apply visitor function to all tasks in the queues of the context. The
+ * deque is left out, as its tasks may be taken at any time, they are
+ * checked by the worker taking them instead.
  * \memberof embb_mtapi_thread_context_struct
  */
 mtapi_boolean_t embb_mtapi_thread_context_process_tasks(
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/internal/config.h>
+#include <embb/base/c/internal/unused.h>
+
+#include <embb_mtapi_topology.h>
+
+/* a cpulist holds one line, longer ones are cut off */
+#define EMBB_MTAPI_TOPOLOGY_CPULIST_SIZE 1024
+
+mtapi_boolean_t embb_mtapi_topology_cpulist_contains(
+  const char * cpulist,
+  unsigned int core_num) {
+  const char * pos = cpulist;
+  char * end;
+  unsigned long first;
+  unsigned long last;
+
+  while ('0' <= *pos && *pos <= '9') {
+    first = strtoul(pos, &end, 10);
+    last = first;
+    pos = end;
+    if ('-' == *pos) {
+      pos++;
+      if (*pos < '0' || '9' < *pos) {
+        break;
+      }
+      last = strtoul(pos, &end, 10);
+      pos = end;
+    }
+    if (first <= core_num && core_num <= last) {
+      return MTAPI_TRUE;
+    }
+    if (',' != *pos) {
+      break;
+    }
+    pos++;
+  }
+  return MTAPI_FALSE;
+}
+
+mtapi_uint_t embb_mtapi_topology_get_numa_domain(unsigned int core_num) {
+  return embb_mtapi_topology_get_numa_domain_in(
+    "/sys/devices/system/node", core_num);
+}
+
+#ifdef __linux__
+
+#include <dirent.h>
+
+mtapi_uint_t embb_mtapi_topology_get_numa_domain_in(
+  const char * node_dir,
+  unsigned int core_num) {
+  mtapi_uint_t domain = 0;
+  DIR * nodes = opendir(node_dir);
+  struct dirent * entry;
+
+  if (NULL == nodes) {
+    return 0;
+  }
+  while (NULL != (entry = readdir(nodes))) {
+    unsigned int node_id;
+    char path[256];
+    char cpulist[EMBB_MTAPI_TOPOLOGY_CPULIST_SIZE];
+    FILE * file;
+    mtapi_boolean_t found;
+
+    /* entries are named node0, node1, ... with possible gaps */
+    if (0 != strncmp(entry->d_name, "node", 4) ||
+      1 != sscanf(entry->d_name + 4, "%u", &node_id)) {
+      continue;
+    }
+    snprintf(path, sizeof(path), "%s/node%u/cpulist", node_dir, node_id);
+    file = fopen(path, "r");
+    if (NULL == file) {
+      continue;
+    }
+    found = (NULL != fgets(cpulist, sizeof(cpulist), file)) ?
+      embb_mtapi_topology_cpulist_contains(cpulist, core_num) : MTAPI_FALSE;
+    fclose(file);
+    if (found) {
+      domain = node_id;
+      break;
+    }
+  }
+  closedir(nodes);
+
+  return domain;
+}
+
+#else /* __linux__ */
+
+mtapi_uint_t embb_mtapi_topology_get_numa_domain_in(
+  const char * node_dir,
+  unsigned int core_num) {
+  EMBB_UNUSED(node_dir);
+  EMBB_UNUSED(core_num);
+  return 0;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MTAPI_C_SRC_EMBB_MTAPI_TOPOLOGY_H_
+#define MTAPI_C_SRC_EMBB_MTAPI_TOPOLOGY_H_
+
+#include <embb/mtapi/c/mtapi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* NUMA domain (memory node) the given core belongs to. Returns 0 if the
+   platform does not expose its topology, so all cores end up in the same
+   domain. On Linux, the domains are read from /sys/devices/system/node. */
+mtapi_uint_t embb_mtapi_topology_get_numa_domain(unsigned int core_num);
+
+/* like embb_mtapi_topology_get_numa_domain, but reads the node<N>/cpulist
+   files below the given directory instead of /sys/devices/system/node */
+mtapi_uint_t embb_mtapi_topology_get_numa_domain_in(
+  const char * node_dir,
+  unsigned int core_num);
+
+/* returns MTAPI_TRUE if core_num is part of a cpu list like "0-3,8,10-11",
+   as found in the cpulist files of the NUMA nodes */
+mtapi_boolean_t embb_mtapi_topology_cpulist_contains(
+  const char * cpulist,
+  unsigned int core_num);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MTAPI_C_SRC_EMBB_MTAPI_TOPOLOGY_H_
@@ -48,9 +48,9 @@ void mtapi_affinity_init(
 
   if (embb_mtapi_node_is_initialized()) {
     if (MTAPI_NULL != mask) {
-      embb_bitset_clear_all(mask);
+      embb_bitset_clear_all(mask->rep);
       if (affinity) {
-        embb_bitset_set_n(mask, node->attributes.num_cores);
+        embb_bitset_set_n(mask->rep, node->attributes.num_cores);
       }
       local_status = MTAPI_SUCCESS;
     } else {
@@ -77,9 +77,9 @@ void mtapi_affinity_set(
     if (MTAPI_NULL != mask) {
       if (core_num < node->attributes.num_cores) {
         if (affinity) {
-          embb_bitset_set(mask, core_num);
+          embb_bitset_set(mask->rep, core_num);
         } else {
-          embb_bitset_clear(mask, core_num);
+          embb_bitset_clear(mask->rep, core_num);
         }
         local_status = MTAPI_SUCCESS;
       } else {
@@ -109,7 +109,7 @@ mtapi_boolean_t mtapi_affinity_get(
     if (MTAPI_NULL != mask) {
       if (core_num < node->attributes.num_cores) {
         affinity =
-          embb_bitset_is_set(mask, core_num) ? MTAPI_TRUE : MTAPI_FALSE;
+          embb_bitset_is_set(mask->rep, core_num) ? MTAPI_TRUE : MTAPI_FALSE;
         local_status = MTAPI_SUCCESS;
       } else {
         local_status = MTAPI_ERR_CORE_NUM;
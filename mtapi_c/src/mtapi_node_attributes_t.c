@@ -52,6 +52,11 @@ void mtapi_nodeattr_init(
     attributes->max_jobs = MTAPI_NODE_MAX_JOBS_DEFAULT;
     attributes->max_actions_per_job = MTAPI_NODE_MAX_ACTIONS_PER_JOB_DEFAULT;
     attributes->max_priorities = MTAPI_NODE_MAX_PRIORITIES_DEFAULT;
+    attributes->scheduler_mode = MTAPI_NODE_SCHEDULER_MODE_DEFAULT;
+    attributes->idle_spin_count = MTAPI_NODE_IDLE_SPIN_COUNT_DEFAULT;
+    attributes->idle_spin_pause = MTAPI_FALSE;
+    attributes->idle_park_timeout = MTAPI_NODE_IDLE_PARK_TIMEOUT_DEFAULT;
+    attributes->idle_adaptive = MTAPI_FALSE;
 
     embb_core_set_init(&attributes->core_affinity, 1);
     attributes->num_cores = embb_core_set_count(&attributes->core_affinity);
@@ -143,6 +148,41 @@ void mtapi_nodeattr_set(
           &attributes->max_priorities, attribute, attribute_size);
         break;
 
+      case MTAPI_NODE_SCHEDULER_MODE: {
+        mtapi_uint_t scheduler_mode;
+        local_status = embb_mtapi_attr_set_mtapi_uint_t(
+          &scheduler_mode, attribute, attribute_size);
+        if (MTAPI_SUCCESS == local_status) {
+          /* the scheduler would silently fall back to VHPF otherwise */
+          if (MTAPI_NODE_SCHEDULER_MODE_HALF_VHPF < scheduler_mode) {
+            local_status = MTAPI_ERR_PARAMETER;
+          } else {
+            attributes->scheduler_mode = scheduler_mode;
+          }
+        }
+        break;
+      }
+
+      case MTAPI_NODE_IDLE_SPIN_COUNT:
+        local_status = embb_mtapi_attr_set_mtapi_uint_t(
+          &attributes->idle_spin_count, attribute, attribute_size);
+        break;
+
+      case MTAPI_NODE_IDLE_SPIN_PAUSE:
+        local_status = embb_mtapi_attr_set_mtapi_boolean_t(
+          &attributes->idle_spin_pause, attribute, attribute_size);
+        break;
+
+      case MTAPI_NODE_IDLE_PARK_TIMEOUT:
+        local_status = embb_mtapi_attr_set_mtapi_timeout_t(
+          &attributes->idle_park_timeout, attribute, attribute_size);
+        break;
+
+      case MTAPI_NODE_IDLE_ADAPTIVE:
+        local_status = embb_mtapi_attr_set_mtapi_boolean_t(
+          &attributes->idle_adaptive, attribute, attribute_size);
+        break;
+
       default:
         /* attribute unknown */
         local_status = MTAPI_ERR_ATTR_NUM;
@@ -26,6 +26,8 @@
 
 #include <stdlib.h>
 #include <embb/base/c/thread.h>
+#include <embb/base/c/atomic.h>
+#include <embb/base/c/core_set.h>
 
 #include <embb_mtapi_test_config.h>
 #include <embb_mtapi_test_group.h>
@@ -69,8 +71,80 @@ static void testGroupAction(
 static void testDoSomethingElse() {
 }
 
+#define CONTINUATION_TASKS 10
+#define CONTINUATION_CHAIN 5
+
+static embb_atomic_int continuation_counter;
+
+/* stores the number of tasks that finished before this one */
+static void testContinuationAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* result_buffer,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  embb_thread_yield();
+  *reinterpret_cast<int*>(result_buffer) =
+    embb_atomic_fetch_and_add_int(&continuation_counter, 1);
+}
+
+#define JOB_FILL_TASK 43
+#define FILL_QUEUE_LIMIT 16
+
+static embb_atomic_int fill_release;
+
+static void testFillerAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+}
+
+/* waits until it is released and then starts detached tasks until the
+   scheduler takes no more, stores the number of started tasks */
+static void testFillAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* result_buffer,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  const mtapi_boolean_t att_val_true = MTAPI_TRUE;
+  mtapi_status_t status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_attributes_t task_attr;
+  mtapi_job_hndl_t job;
+  int started = 0;
+
+  while (0 == embb_atomic_load_int(&fill_release)) {
+    embb_thread_yield();
+  }
+
+  mtapi_taskattr_init(&task_attr, &status);
+  mtapi_taskattr_set(&task_attr, MTAPI_TASK_DETACHED,
+    &att_val_true, sizeof(mtapi_boolean_t), &status);
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  while (MTAPI_SUCCESS == status) {
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0, MTAPI_NULL, 0,
+      &task_attr, MTAPI_GROUP_NONE, &status);
+    if (MTAPI_SUCCESS == status) {
+      started++;
+    }
+  }
+  *reinterpret_cast<int*>(result_buffer) = started;
+}
+
 GroupTest::GroupTest() {
   CreateUnit("mtapi group test").Add(&GroupTest::TestBasic, this, 1, 1000);
+  CreateUnit("mtapi group continuation test")
+    .Add(&GroupTest::TestContinuation, this);
+  CreateUnit("mtapi group continuation limit test")
+    .Add(&GroupTest::TestContinuationLimit, this);
 }
 
 void GroupTest::TestBasic() {
@@ -197,3 +271,218 @@ void GroupTest::TestBasic() {
 
   embb_mtapi_log_info("...done\n\n");
 }
+
+void GroupTest::TestContinuation() {
+  mtapi_status_t status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_task_hndl_t chain[CONTINUATION_CHAIN];
+  mtapi_task_hndl_t task;
+  int chain_results[CONTINUATION_CHAIN];
+  int group_results[CONTINUATION_TASKS];
+  int continuation_result = -1;
+  int ii;
+
+  embb_mtapi_log_info("running testGroupContinuation...\n");
+
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  action = mtapi_action_create(JOB_TEST_TASK, testContinuationAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* ---- mtapi_task_continue_with test ---- */
+
+  embb_atomic_store_int(&continuation_counter, 0);
+  chain[0] = mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0,
+    &chain_results[0], sizeof(int), MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE, &status);
+  MTAPI_CHECK_STATUS(status);
+  for (ii = 1; ii < CONTINUATION_CHAIN; ii++) {
+    chain[ii] = mtapi_task_continue_with(chain[ii - 1], MTAPI_TASK_ID_NONE,
+      job, MTAPI_NULL, 0, &chain_results[ii], sizeof(int),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES, MTAPI_GROUP_NONE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  /* waiting for the last task of the chain is enough */
+  mtapi_task_wait(chain[CONTINUATION_CHAIN - 1], MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  for (ii = 0; ii < CONTINUATION_CHAIN - 1; ii++) {
+    mtapi_task_wait(chain[ii], 0, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  for (ii = 0; ii < CONTINUATION_CHAIN; ii++) {
+    PT_EXPECT_EQ(chain_results[ii], ii);
+  }
+
+  /* a predecessor that is done already starts its continuation right
+     away */
+  chain_results[0] = -1;
+  task = mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0,
+    &chain_results[0], sizeof(int), MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE, &status);
+  MTAPI_CHECK_STATUS(status);
+  while (-1 == *static_cast<volatile int*>(&chain_results[0])) {
+    embb_thread_yield();
+  }
+  embb_thread_yield();
+  chain[0] = mtapi_task_continue_with(task, MTAPI_TASK_ID_NONE, job,
+    MTAPI_NULL, 0, &chain_results[1], sizeof(int),
+    MTAPI_DEFAULT_TASK_ATTRIBUTES, MTAPI_GROUP_NONE, &status);
+  MTAPI_CHECK_STATUS(status);
+  mtapi_task_wait(chain[0], MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(chain_results[1], chain_results[0] + 1);
+
+  /* ---- mtapi_group_continue_with test ---- */
+
+  embb_atomic_store_int(&continuation_counter, 0);
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+  for (ii = 0; ii < CONTINUATION_TASKS; ii++) {
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0,
+      &group_results[ii], sizeof(int), MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      group, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  task = mtapi_group_continue_with(group, MTAPI_TASK_ID_NONE, job,
+    MTAPI_NULL, 0, &continuation_result, sizeof(int),
+    MTAPI_DEFAULT_TASK_ATTRIBUTES, MTAPI_GROUP_NONE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* the continuation runs after all tasks of the group */
+  mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(continuation_result, CONTINUATION_TASKS);
+
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* an invalid predecessor is rejected */
+  mtapi_task_continue_with(chain[0], MTAPI_TASK_ID_NONE, job,
+    MTAPI_NULL, 0, MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE, &status);
+  PT_EXPECT_EQ(status, MTAPI_ERR_TASK_INVALID);
+  mtapi_group_continue_with(group, MTAPI_TASK_ID_NONE, job,
+    MTAPI_NULL, 0, MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE, &status);
+  PT_EXPECT_EQ(status, MTAPI_ERR_GROUP_INVALID);
+
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void GroupTest::TestContinuationLimit() {
+  mtapi_status_t status = MTAPI_ERR_UNKNOWN;
+  mtapi_node_attributes_t node_attr;
+  mtapi_task_attributes_t detached_attr;
+  embb_core_set_t core_set;
+  mtapi_action_hndl_t fill_action;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t fill_job;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_task_hndl_t chain[2];
+  mtapi_task_hndl_t task;
+  const mtapi_boolean_t att_val_true = MTAPI_TRUE;
+  int filled = 0;
+
+  embb_mtapi_log_info("running testGroupContinuationLimit...\n");
+
+  /* a single worker with small queues is easy to fill up */
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+  embb_core_set_init(&core_set, 0);
+  embb_core_set_add(&core_set, 0);
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_CORE_AFFINITY,
+    &core_set, MTAPI_NODE_CORE_AFFINITY_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_QUEUE_LIMIT,
+    MTAPI_ATTRIBUTE_VALUE(FILL_QUEUE_LIMIT),
+    MTAPI_ATTRIBUTE_POINTER_AS_VALUE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID,
+    &node_attr, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  fill_action = mtapi_action_create(JOB_FILL_TASK, testFillAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+  action = mtapi_action_create(JOB_TEST_TASK, testFillerAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  fill_job = mtapi_job_get(JOB_FILL_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_taskattr_init(&detached_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+  mtapi_taskattr_set(&detached_attr, MTAPI_TASK_DETACHED,
+    &att_val_true, sizeof(mtapi_boolean_t), &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* the predecessor fills the queues of the only worker it runs on, so
+     none of its continuations can be scheduled once it is done */
+  embb_atomic_store_int(&fill_release, 0);
+  task = mtapi_task_start(MTAPI_TASK_ID_NONE, fill_job,
+    MTAPI_NULL, 0, &filled, sizeof(int),
+    MTAPI_DEFAULT_TASK_ATTRIBUTES, MTAPI_GROUP_NONE, &status);
+  MTAPI_CHECK_STATUS(status);
+  chain[0] = mtapi_task_continue_with(task, MTAPI_TASK_ID_NONE, job,
+    MTAPI_NULL, 0, MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    group, &status);
+  MTAPI_CHECK_STATUS(status);
+  chain[1] = mtapi_task_continue_with(chain[0], MTAPI_TASK_ID_NONE, job,
+    MTAPI_NULL, 0, MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE, &status);
+  MTAPI_CHECK_STATUS(status);
+  mtapi_task_continue_with(chain[0], MTAPI_TASK_ID_NONE, job,
+    MTAPI_NULL, 0, MTAPI_NULL, 0, &detached_attr,
+    MTAPI_GROUP_NONE, &status);
+  MTAPI_CHECK_STATUS(status);
+  embb_atomic_store_int(&fill_release, 1);
+
+  mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT(0 < filled);
+
+  /* the failed continuation still completes its group and passes the
+     failure on to its own continuations */
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  PT_EXPECT_EQ(status, MTAPI_ERR_TASK_LIMIT);
+  mtapi_task_wait(chain[1], MTAPI_INFINITE, &status);
+  PT_EXPECT_EQ(status, MTAPI_ERR_TASK_LIMIT);
+
+  /* deleting the action waits for the detached tasks */
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  mtapi_action_delete(fill_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
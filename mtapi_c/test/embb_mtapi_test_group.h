@@ -35,6 +35,8 @@ class GroupTest : public partest::TestCase {
 
  private:
   void TestBasic();
+  void TestContinuation();
+  void TestContinuationLimit();
 };
 
 #endif // MTAPI_C_TEST_EMBB_MTAPI_TEST_GROUP_H_
@@ -30,10 +30,16 @@
 #include <embb_mtapi_test_queue.h>
 
 #include <embb/base/c/internal/unused.h>
+#include <embb/base/c/atomic.h>
+#include <embb/base/c/thread.h>
 
 #define JOB_TEST_TASK 42
 #define TASK_TEST_ID 23
 #define QUEUE_TEST_ID 17
+#define ORDERED_QUEUES 4
+#define ORDERED_TASKS 100
+#define RETAINED_TASKS 16
+#define DELETED_TASKS 8
 
 static void testQueueAction(
   const void* args,
@@ -57,8 +63,67 @@ static void testQueueAction(
 static void testDoSomethingElse() {
 }
 
+static embb_atomic_int ordered_running[ORDERED_QUEUES];
+static int ordered_next[ORDERED_QUEUES];
+static embb_atomic_int ordered_errors;
+
+static void testOrderedAction(
+  const void* args,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  const int* arg = reinterpret_cast<const int*>(args);
+  int queue_index = arg[0];
+  /* no other task of the same queue may run at the same time */
+  if (0 != embb_atomic_fetch_and_add_int(&ordered_running[queue_index], 1)) {
+    embb_atomic_fetch_and_add_int(&ordered_errors, 1);
+  }
+  /* and the tasks have to run in the order they were enqueued */
+  if (ordered_next[queue_index] != arg[1]) {
+    embb_atomic_fetch_and_add_int(&ordered_errors, 1);
+  }
+  ordered_next[queue_index] = arg[1] + 1;
+  embb_atomic_fetch_and_add_int(&ordered_running[queue_index], -1);
+}
+
+static embb_atomic_int ordered_blocked;
+static embb_atomic_int ordered_blocking;
+
+static void testOrderedBlockingAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  embb_atomic_store_int(&ordered_blocking, 1);
+  while (0 != embb_atomic_load_int(&ordered_blocked)) {
+    embb_thread_yield();
+  }
+  embb_atomic_store_int(&ordered_blocking, 0);
+}
+
+static embb_atomic_int retained_count;
+
+static void testRetainAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  embb_atomic_fetch_and_add_int(&retained_count, 1);
+}
+
 QueueTest::QueueTest() {
   CreateUnit("mtapi queue test").Add(&QueueTest::TestBasic, this);
+  CreateUnit("mtapi ordered queue test").Add(&QueueTest::TestOrdered, this);
+  CreateUnit("mtapi retaining queue test").Add(&QueueTest::TestRetain, this);
 }
 
 void QueueTest::TestBasic() {
@@ -131,3 +196,214 @@ void QueueTest::TestBasic() {
 
   embb_mtapi_log_info("...done\n\n");
 }
+
+void QueueTest::TestOrdered() {
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_queue_hndl_t queue[ORDERED_QUEUES];
+  int args[ORDERED_QUEUES][ORDERED_TASKS][2];
+  int ii, jj;
+
+  embb_mtapi_log_info("running testOrdered...\n");
+
+  embb_atomic_store_int(&ordered_errors, 0);
+  for (ii = 0; ii < ORDERED_QUEUES; ii++) {
+    embb_atomic_store_int(&ordered_running[ii], 0);
+    ordered_next[ii] = 0;
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_TASK, testOrderedAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* queues are ordered by default */
+  for (ii = 0; ii < ORDERED_QUEUES; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    queue[ii] = mtapi_queue_create(QUEUE_TEST_ID + ii, job,
+      MTAPI_DEFAULT_QUEUE_ATTRIBUTES, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  /* interleave the queues, so their tasks may run side by side */
+  for (jj = 0; jj < ORDERED_TASKS; jj++) {
+    for (ii = 0; ii < ORDERED_QUEUES; ii++) {
+      args[ii][jj][0] = ii;
+      args[ii][jj][1] = jj;
+      status = MTAPI_ERR_UNKNOWN;
+      mtapi_task_enqueue(MTAPI_TASK_ID_NONE, queue[ii],
+        args[ii][jj], sizeof(args[ii][jj]), MTAPI_NULL, 0,
+        MTAPI_DEFAULT_TASK_ATTRIBUTES, group, &status);
+      MTAPI_CHECK_STATUS(status);
+    }
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_atomic_load_int(&ordered_errors), 0);
+  for (ii = 0; ii < ORDERED_QUEUES; ii++) {
+    PT_EXPECT_EQ(ordered_next[ii], ORDERED_TASKS);
+  }
+
+  for (ii = 0; ii < ORDERED_QUEUES; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_queue_delete(queue[ii], MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* deleting a queue while its first task runs must not leave the tasks
+     waiting behind it hanging */
+  embb_atomic_store_int(&ordered_blocked, 1);
+  embb_atomic_store_int(&ordered_blocking, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_TASK, testOrderedBlockingAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  queue[0] = mtapi_queue_create(QUEUE_TEST_ID, job,
+    MTAPI_DEFAULT_QUEUE_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_task_hndl_t tasks[DELETED_TASKS];
+  for (ii = 0; ii < DELETED_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    tasks[ii] = mtapi_task_enqueue(MTAPI_TASK_ID_NONE, queue[0],
+      MTAPI_NULL, 0, MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  while (0 == embb_atomic_load_int(&ordered_blocking)) {
+    embb_thread_yield();
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queue_delete(queue[0], 10, &status);
+  PT_EXPECT_EQ(status, MTAPI_TIMEOUT);
+
+  /* the first task is still running, the others are finished already */
+  for (ii = 1; ii < DELETED_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_wait(tasks[ii], MTAPI_INFINITE, &status);
+    PT_EXPECT_EQ(status, MTAPI_ERR_QUEUE_DELETED);
+  }
+
+  embb_atomic_store_int(&ordered_blocked, 0);
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void QueueTest::TestRetain() {
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_queue_attributes_t queue_attr;
+  mtapi_queue_hndl_t queue;
+  mtapi_task_hndl_t task[RETAINED_TASKS];
+  int ii;
+
+  embb_mtapi_log_info("running testRetain...\n");
+
+  embb_atomic_store_int(&retained_count, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_TASK, testRetainAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queueattr_init(&queue_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queueattr_set(&queue_attr, MTAPI_QUEUE_RETAIN,
+    MTAPI_ATTRIBUTE_VALUE(MTAPI_TRUE), MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  queue = mtapi_queue_create(QUEUE_TEST_ID, job, &queue_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queue_disable(queue, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* a disabled retaining queue accepts tasks, but holds them back */
+  for (ii = 0; ii < RETAINED_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    task[ii] = mtapi_task_enqueue(MTAPI_TASK_ID_NONE, queue,
+      MTAPI_NULL, 0, MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(task[0], 10, &status);
+  PT_EXPECT_EQ(status, MTAPI_TIMEOUT);
+  PT_EXPECT_EQ(embb_atomic_load_int(&retained_count), 0);
+
+  /* enabling the queue releases all of them */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queue_enable(queue, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (ii = 0; ii < RETAINED_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_wait(task[ii], MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  PT_EXPECT_EQ(embb_atomic_load_int(&retained_count), RETAINED_TASKS);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queue_delete(queue, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
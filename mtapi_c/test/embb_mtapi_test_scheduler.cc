@@ -0,0 +1,578 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <string.h>
+
+#include <embb_mtapi_test_config.h>
+#include <embb_mtapi_test_scheduler.h>
+
+#include <embb/base/c/atomic.h>
+#include <embb/base/c/thread.h>
+#include <embb/base/c/core_set.h>
+
+#include <embb_mtapi_alloc.h>
+#include <embb_mtapi_scheduler_t.h>
+#include <embb_mtapi_thread_context_t.h>
+#include <embb_mtapi_topology.h>
+
+#define JOB_TEST_SCHEDULER 17
+#define TASK_TEST_ID 42
+#define TREE_DEPTH 8
+#define TREE_NODES ((1 << (TREE_DEPTH + 1)) - 1)
+#define FIBONACCI_N 12
+#define FIBONACCI_RESULT 144
+#define JOB_TEST_DEQUE 18
+#define DEQUE_TASKS 8
+#define VICTIM_WORKERS 6
+
+static const int tree_depths[TREE_DEPTH + 1] = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+static embb_atomic_int tree_nodes_visited;
+
+static void testSchedulerTreeAction(
+  const void* args,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  int depth = *reinterpret_cast<const int*>(args);
+  int ii;
+
+  embb_atomic_fetch_and_add_int(&tree_nodes_visited, 1);
+
+  if (0 < depth) {
+    /* spawn children from within the worker, they are detached, so nobody
+       needs to wait for them */
+    mtapi_status_t status;
+    mtapi_task_attributes_t task_attr;
+    mtapi_job_hndl_t job =
+      mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+    mtapi_taskattr_init(&task_attr, &status);
+    mtapi_taskattr_set(&task_attr, MTAPI_TASK_DETACHED,
+      MTAPI_ATTRIBUTE_VALUE(MTAPI_TRUE), MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+      &status);
+    for (ii = 0; ii < 2; ii++) {
+      mtapi_task_start(
+        MTAPI_TASK_ID_NONE, job,
+        &tree_depths[depth - 1], sizeof(int), MTAPI_NULL, 0,
+        &task_attr, MTAPI_GROUP_NONE, &status);
+    }
+  }
+}
+
+static void testSchedulerFibonacciAction(
+  const void* args,
+  mtapi_size_t /*arg_size*/,
+  void* result_buffer,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* task_context) {
+  int n = *reinterpret_cast<const int*>(args);
+  int* result = reinterpret_cast<int*>(result_buffer);
+
+  if (n < 2) {
+    *result = n;
+  } else {
+    /* start one half as a task and wait for it from within the worker */
+    mtapi_status_t status;
+    int a = n - 1;
+    int b = n - 2;
+    int x = 0;
+    int y = 0;
+    mtapi_job_hndl_t job =
+      mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+    mtapi_task_hndl_t task = mtapi_task_start(
+      MTAPI_TASK_ID_NONE, job, &a, sizeof(int), &x, sizeof(int),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES, MTAPI_GROUP_NONE, &status);
+    testSchedulerFibonacciAction(
+      &b, sizeof(int), &y, sizeof(int), MTAPI_NULL, 0, task_context);
+    mtapi_task_wait(task, MTAPI_INFINITE, &status);
+    *result = x + y;
+  }
+}
+
+static mtapi_task_hndl_t deque_tasks[DEQUE_TASKS];
+static embb_atomic_int deque_spawned;
+static embb_atomic_int deque_release;
+static embb_atomic_int deque_executed;
+
+static void testSchedulerDequeAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  embb_atomic_fetch_and_add_int(&deque_executed, 1);
+}
+
+/* starts tasks from within a worker, so they end up in its deque, and
+   keeps the worker busy until it is released */
+static void testSchedulerSpawnAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job = mtapi_job_get(JOB_TEST_DEQUE, THIS_DOMAIN_ID,
+    &status);
+  for (int ii = 0; ii < DEQUE_TASKS; ii++) {
+    deque_tasks[ii] = mtapi_task_start(MTAPI_TASK_ID_NONE, job,
+      MTAPI_NULL, 0, MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE, &status);
+  }
+  embb_atomic_store_int(&deque_spawned, 1);
+  while (0 == embb_atomic_load_int(&deque_release)) {
+    embb_thread_yield();
+  }
+}
+
+SchedulerTest::SchedulerTest() {
+  CreateUnit("mtapi scheduler modes test")
+    .Add(&SchedulerTest::TestModes, this);
+  CreateUnit("mtapi scheduler nested wait test")
+    .Add(&SchedulerTest::TestNestedWait, this);
+  CreateUnit("mtapi scheduler idle policy test")
+    .Add(&SchedulerTest::TestIdlePolicy, this);
+  CreateUnit("mtapi scheduler deque cancel test")
+    .Add(&SchedulerTest::TestDequeCancel, this);
+  CreateUnit("mtapi scheduler topology test")
+    .Add(&SchedulerTest::TestTopology, this);
+  CreateUnit("mtapi scheduler victim order test")
+    .Add(&SchedulerTest::TestVictimOrder, this);
+}
+
+void SchedulerTest::RunTree(mtapi_node_attributes_t * node_attr) {
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_task_hndl_t task;
+
+  embb_atomic_store_int(&tree_nodes_visited, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(
+    THIS_DOMAIN_ID,
+    THIS_NODE_ID,
+    node_attr,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(
+    JOB_TEST_SCHEDULER,
+    testSchedulerTreeAction,
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  task = mtapi_task_start(
+    TASK_TEST_ID,
+    job,
+    &tree_depths[TREE_DEPTH],
+    sizeof(int),
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* the children are detached, so wait until the whole tree is done */
+  while (TREE_NODES > embb_atomic_load_int(&tree_nodes_visited)) {
+    embb_thread_yield();
+  }
+  PT_EXPECT_EQ(embb_atomic_load_int(&tree_nodes_visited), TREE_NODES);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+}
+
+void SchedulerTest::TestModes() {
+  const mtapi_uint_t modes[] = {
+    MTAPI_NODE_SCHEDULER_MODE_VHPF,
+    MTAPI_NODE_SCHEDULER_MODE_LF,
+    MTAPI_NODE_SCHEDULER_MODE_RANDOM_VHPF,
+    MTAPI_NODE_SCHEDULER_MODE_HALF_VHPF
+  };
+  mtapi_node_attributes_t node_attr;
+  mtapi_status_t status;
+  size_t ii;
+
+  embb_mtapi_log_info("running testSchedulerModes...\n");
+
+  for (ii = 0; ii < sizeof(modes) / sizeof(modes[0]); ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_nodeattr_init(&node_attr, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_nodeattr_set(
+      &node_attr,
+      MTAPI_NODE_SCHEDULER_MODE,
+      &modes[ii],
+      MTAPI_NODE_SCHEDULER_MODE_SIZE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+
+    RunTree(&node_attr);
+  }
+
+  /* unknown modes are rejected and leave the attributes alone */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_SUCCESS;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_SCHEDULER_MODE,
+    MTAPI_ATTRIBUTE_VALUE(MTAPI_NODE_SCHEDULER_MODE_HALF_VHPF + 1),
+    MTAPI_ATTRIBUTE_POINTER_AS_VALUE, &status);
+  PT_EXPECT_EQ(status, MTAPI_ERR_PARAMETER);
+  PT_EXPECT_EQ(node_attr.scheduler_mode,
+    (mtapi_uint_t)MTAPI_NODE_SCHEDULER_MODE_DEFAULT);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void SchedulerTest::TestIdlePolicy() {
+  mtapi_node_attributes_t node_attr;
+  mtapi_status_t status;
+
+  embb_mtapi_log_info("running testSchedulerIdlePolicy...\n");
+
+  /* short pause based spinning, adaptive, parked workers sleep until woken
+     up, finalize must still be able to stop them */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_IDLE_SPIN_COUNT,
+    MTAPI_ATTRIBUTE_VALUE(16), MTAPI_ATTRIBUTE_POINTER_AS_VALUE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_IDLE_SPIN_PAUSE,
+    MTAPI_ATTRIBUTE_VALUE(MTAPI_TRUE), MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_IDLE_PARK_TIMEOUT,
+    MTAPI_ATTRIBUTE_VALUE(MTAPI_INFINITE), MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_IDLE_ADAPTIVE,
+    MTAPI_ATTRIBUTE_VALUE(MTAPI_TRUE), MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  RunTree(&node_attr);
+
+  /* no spinning at all, park for a short time */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_IDLE_SPIN_COUNT,
+    MTAPI_ATTRIBUTE_VALUE(0), MTAPI_ATTRIBUTE_POINTER_AS_VALUE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_IDLE_PARK_TIMEOUT,
+    MTAPI_ATTRIBUTE_VALUE(1), MTAPI_ATTRIBUTE_POINTER_AS_VALUE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  RunTree(&node_attr);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void SchedulerTest::TestNestedWait() {
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_task_hndl_t task;
+  int n = FIBONACCI_N;
+  int result = 0;
+
+  embb_mtapi_log_info("running testSchedulerNestedWait...\n");
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(
+    THIS_DOMAIN_ID,
+    THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(
+    JOB_TEST_SCHEDULER,
+    testSchedulerFibonacciAction,
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  task = mtapi_task_start(
+    TASK_TEST_ID,
+    job,
+    &n,
+    sizeof(int),
+    &result,
+    sizeof(int),
+    MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(result, FIBONACCI_RESULT);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void SchedulerTest::TestDequeCancel() {
+  mtapi_status_t status;
+  mtapi_node_attributes_t node_attr;
+  embb_core_set_t core_set;
+  mtapi_action_hndl_t spawn_action;
+  mtapi_action_hndl_t deque_action;
+  mtapi_job_hndl_t job;
+  mtapi_task_hndl_t task;
+
+  embb_mtapi_log_info("running testSchedulerDequeCancel...\n");
+
+  /* a single worker cannot steal the tasks from its own deque */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+  embb_core_set_init(&core_set, 0);
+  embb_core_set_add(&core_set, 0);
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_CORE_AFFINITY,
+    &core_set, MTAPI_NODE_CORE_AFFINITY_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(
+    THIS_DOMAIN_ID,
+    THIS_NODE_ID,
+    &node_attr,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  spawn_action = mtapi_action_create(JOB_TEST_SCHEDULER,
+    testSchedulerSpawnAction, MTAPI_NULL, 0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  deque_action = mtapi_action_create(JOB_TEST_DEQUE,
+    testSchedulerDequeAction, MTAPI_NULL, 0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_atomic_store_int(&deque_spawned, 0);
+  embb_atomic_store_int(&deque_release, 0);
+  embb_atomic_store_int(&deque_executed, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  task = mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES, MTAPI_GROUP_NONE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+  while (0 == embb_atomic_load_int(&deque_spawned)) {
+    embb_thread_yield();
+  }
+
+  /* the tasks wait in the deque of the busy worker */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_disable(deque_action, 10, &status);
+  PT_EXPECT_EQ(status, MTAPI_TIMEOUT);
+  embb_atomic_store_int(&deque_release, 1);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* they are cancelled when the worker takes them */
+  for (int ii = 0; ii < DEQUE_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_wait(deque_tasks[ii], MTAPI_INFINITE, &status);
+    PT_EXPECT_EQ(status, MTAPI_ERR_ACTION_DISABLED);
+  }
+  PT_EXPECT_EQ(embb_atomic_load_int(&deque_executed), 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(deque_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(spawn_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void SchedulerTest::TestTopology() {
+  embb_mtapi_log_info("running testSchedulerTopology...\n");
+
+  /* ranges and single cores, as found in node<N>/cpulist */
+  PT_EXPECT(embb_mtapi_topology_cpulist_contains("0-3,8,10-11\n", 0));
+  PT_EXPECT(embb_mtapi_topology_cpulist_contains("0-3,8,10-11\n", 3));
+  PT_EXPECT(!embb_mtapi_topology_cpulist_contains("0-3,8,10-11\n", 4));
+  PT_EXPECT(embb_mtapi_topology_cpulist_contains("0-3,8,10-11\n", 8));
+  PT_EXPECT(!embb_mtapi_topology_cpulist_contains("0-3,8,10-11\n", 9));
+  PT_EXPECT(embb_mtapi_topology_cpulist_contains("0-3,8,10-11\n", 11));
+  PT_EXPECT(!embb_mtapi_topology_cpulist_contains("0-3,8,10-11\n", 12));
+  PT_EXPECT(embb_mtapi_topology_cpulist_contains("5", 5));
+  PT_EXPECT(!embb_mtapi_topology_cpulist_contains("5", 4));
+  PT_EXPECT(embb_mtapi_topology_cpulist_contains("2,4\n", 4));
+  PT_EXPECT(!embb_mtapi_topology_cpulist_contains("2,4\n", 3));
+  PT_EXPECT(embb_mtapi_topology_cpulist_contains("64-127\n", 100));
+
+  /* nodes without cores and broken lists contain nothing */
+  PT_EXPECT(!embb_mtapi_topology_cpulist_contains("\n", 0));
+  PT_EXPECT(!embb_mtapi_topology_cpulist_contains("", 0));
+  PT_EXPECT(!embb_mtapi_topology_cpulist_contains("1-", 1));
+  PT_EXPECT(!embb_mtapi_topology_cpulist_contains("x0-3", 0));
+
+  /* without topology information all cores are in domain 0 */
+  PT_EXPECT_EQ(embb_mtapi_topology_get_numa_domain_in(
+    "/nonexistent/embb/node", 0), 0u);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void SchedulerTest::TestVictimOrder() {
+  embb_mtapi_scheduler_t scheduler;
+  embb_mtapi_thread_context_t contexts[VICTIM_WORKERS];
+  /* workers of both domains alternate */
+  const mtapi_uint_t expected_first[VICTIM_WORKERS - 1] = { 2, 4, 1, 3, 5 };
+  const mtapi_uint_t expected_rotated[VICTIM_WORKERS - 1] = { 4, 2, 3, 5, 1 };
+  mtapi_uint_t ii;
+  mtapi_uint_t kk;
+
+  embb_mtapi_log_info("running testSchedulerVictimOrder...\n");
+
+  memset(&scheduler, 0, sizeof(scheduler));
+  memset(contexts, 0, sizeof(contexts));
+  scheduler.worker_count = VICTIM_WORKERS;
+  scheduler.worker_contexts = contexts;
+  for (ii = 0; ii < VICTIM_WORKERS; ii++) {
+    contexts[ii].worker_index = ii;
+    contexts[ii].numa_domain = ii % 2;
+  }
+  embb_mtapi_scheduler_initialize_victims(&scheduler);
+
+  for (kk = 0; kk < VICTIM_WORKERS - 1; kk++) {
+    PT_EXPECT_EQ(embb_mtapi_scheduler_get_victim(
+      &scheduler, &contexts[0], 0, kk)->worker_index, expected_first[kk]);
+    PT_EXPECT_EQ(embb_mtapi_scheduler_get_victim(
+      &scheduler, &contexts[0], 1, kk)->worker_index, expected_rotated[kk]);
+  }
+
+  /* every other worker is visited once, the local ones first */
+  for (ii = 0; ii < VICTIM_WORKERS; ii++) {
+    mtapi_uint_t visited[VICTIM_WORKERS] = { 0 };
+    PT_EXPECT_EQ(contexts[ii].local_victim_count,
+      static_cast<mtapi_uint_t>(VICTIM_WORKERS / 2 - 1));
+    for (kk = 0; kk < VICTIM_WORKERS - 1; kk++) {
+      embb_mtapi_thread_context_t * victim =
+        embb_mtapi_scheduler_get_victim(&scheduler, &contexts[ii], ii, kk);
+      PT_EXPECT(victim != &contexts[ii]);
+      PT_EXPECT_EQ(victim->numa_domain == contexts[ii].numa_domain,
+        kk < contexts[ii].local_victim_count);
+      visited[victim->worker_index]++;
+    }
+    for (kk = 0; kk < VICTIM_WORKERS; kk++) {
+      PT_EXPECT_EQ(visited[kk], (kk == ii) ? 0u : 1u);
+    }
+  }
+
+  for (ii = 0; ii < VICTIM_WORKERS; ii++) {
+    embb_mtapi_alloc_deallocate(contexts[ii].victims);
+  }
+
+  embb_mtapi_log_info("...done\n\n");
+}
@@ -30,9 +30,15 @@
 #include <embb_mtapi_test_task.h>
 
 #include <embb/base/c/internal/unused.h>
+#include <embb/base/c/atomic.h>
+#include <embb/base/c/thread.h>
 
 #define JOB_TEST_TASK 42
 #define TASK_TEST_ID 23
+#define LARGE_POOL_TASKS 4096
+#define BATCH_TASKS 1000
+#define TASK_INSTANCES 16
+#define BATCH_INSTANCE_TASKS 4
 
 static void testTaskAction(
   const void* args,
@@ -55,8 +61,112 @@ static void testTaskAction(
 static void testDoSomethingElse() {
 }
 
+static embb_atomic_int task_release;
+
+static void testTaskBlockedAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  while (0 == embb_atomic_load_int(&task_release)) {
+    embb_thread_yield();
+  }
+}
+
+static void testTaskCountAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+}
+
+static void testTaskDoubleAction(
+  const void* args,
+  mtapi_size_t /*arg_size*/,
+  void* result_buffer,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  *static_cast<int*>(result_buffer) = 2 * *static_cast<const int*>(args);
+}
+
+static embb_atomic_int cancel_started;
+static embb_atomic_int cancel_returned;
+
+static void testTaskCancelledAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* task_context) {
+  embb_atomic_store_int(&cancel_started, 1);
+  while (MTAPI_TASK_CANCELLED !=
+    mtapi_context_taskstate_get(task_context, MTAPI_NULL)) {
+    embb_thread_yield();
+  }
+  /* keep running a little while after the cancellation */
+  for (int ii = 0; ii < 1000; ii++) {
+    embb_thread_yield();
+  }
+  embb_atomic_store_int(&cancel_returned, 1);
+}
+
+static embb_atomic_int instance_count;
+
+static void testTaskInstanceAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* result_buffer,
+  mtapi_size_t result_buffer_size,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* task_context) {
+  mtapi_uint_t num_instances =
+    mtapi_context_numinst_get(task_context, MTAPI_NULL);
+  if (TASK_INSTANCES == num_instances &&
+    sizeof(mtapi_uint_t) == result_buffer_size) {
+    *static_cast<mtapi_uint_t*>(result_buffer) =
+      mtapi_context_instnum_get(task_context, MTAPI_NULL);
+  }
+  embb_atomic_fetch_and_add_int(&instance_count, 1);
+}
+
+static void testTaskCountingAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* node_local_data,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  embb_atomic_int* counter = const_cast<embb_atomic_int*>(
+    static_cast<const embb_atomic_int*>(node_local_data));
+  embb_atomic_fetch_and_add_int(counter, 1);
+}
+
 TaskTest::TaskTest() {
   CreateUnit("mtapi task test").Add(&TaskTest::TestBasic, this);
+  CreateUnit("mtapi large task pool test")
+    .Add(&TaskTest::TestLargePool, this);
+  CreateUnit("mtapi blocking task wait test")
+    .Add(&TaskTest::TestBlockingWait, this);
+  CreateUnit("mtapi batch task start test")
+    .Add(&TaskTest::TestStartBatch, this);
+  CreateUnit("mtapi multi-instance task test")
+    .Add(&TaskTest::TestMultiInstance, this);
+  CreateUnit("mtapi action load balancing test")
+    .Add(&TaskTest::TestLoadBalancing, this);
+  CreateUnit("mtapi task cancel test")
+    .Add(&TaskTest::TestCancel, this);
 }
 
 void TaskTest::TestBasic() {
@@ -164,3 +274,595 @@ void TaskTest::TestBasic() {
 
   embb_mtapi_log_info("...done\n\n");
 }
+
+void TaskTest::TestLargePool() {
+  mtapi_node_attributes_t node_attr;
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_task_hndl_t * task;
+  mtapi_uint_t max_tasks = 1 << 20;
+  int ii;
+
+  embb_mtapi_log_info("running testLargePool...\n");
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* task storage is allocated on demand, so this is cheap */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(
+    &node_attr,
+    MTAPI_NODE_MAX_TASKS,
+    &max_tasks,
+    MTAPI_NODE_MAX_TASKS_SIZE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* the scheduler queues have to hold all tasks started at once */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(
+    &node_attr,
+    MTAPI_NODE_QUEUE_LIMIT,
+    MTAPI_ATTRIBUTE_VALUE(LARGE_POOL_TASKS),
+    MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(
+    THIS_DOMAIN_ID,
+    THIS_NODE_ID,
+    &node_attr,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(
+    JOB_TEST_TASK,
+    testTaskCountAction,
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* keep more tasks alive than the default pool could hold */
+  task = static_cast<mtapi_task_hndl_t*>(
+    malloc(sizeof(mtapi_task_hndl_t) * LARGE_POOL_TASKS));
+  for (ii = 0; ii < LARGE_POOL_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    task[ii] = mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      job,
+      MTAPI_NULL,
+      0,
+      MTAPI_NULL,
+      0,
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  for (ii = 0; ii < LARGE_POOL_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_wait(task[ii], MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  free(task);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void TaskTest::TestBlockingWait() {
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_task_hndl_t task;
+
+  embb_mtapi_log_info("running testBlockingWait...\n");
+
+  embb_atomic_store_int(&task_release, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(
+    THIS_DOMAIN_ID,
+    THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(
+    JOB_TEST_TASK,
+    testTaskBlockedAction,
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  task = mtapi_task_start(
+    TASK_TEST_ID,
+    job,
+    MTAPI_NULL,
+    0,
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* the main thread is no worker, so it blocks until the timeout */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(task, 10, &status);
+  PT_EXPECT_EQ(status, MTAPI_TIMEOUT);
+
+  /* finishing the task wakes up the blocked thread */
+  embb_atomic_store_int(&task_release, 1);
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void TaskTest::TestStartBatch() {
+  mtapi_node_attributes_t node_attr;
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_task_hndl_t * task;
+  mtapi_uint_t started;
+  int * args;
+  int * results;
+  int ii;
+
+  embb_mtapi_log_info("running testStartBatch...\n");
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(
+    &node_attr,
+    MTAPI_NODE_MAX_TASKS,
+    MTAPI_ATTRIBUTE_VALUE(2 * BATCH_TASKS),
+    MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(
+    &node_attr,
+    MTAPI_NODE_QUEUE_LIMIT,
+    MTAPI_ATTRIBUTE_VALUE(BATCH_TASKS),
+    MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(
+    THIS_DOMAIN_ID,
+    THIS_NODE_ID,
+    &node_attr,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(
+    JOB_TEST_TASK,
+    testTaskDoubleAction,
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  task = static_cast<mtapi_task_hndl_t*>(
+    malloc(sizeof(mtapi_task_hndl_t) * BATCH_TASKS));
+  args = static_cast<int*>(malloc(sizeof(int) * BATCH_TASKS));
+  results = static_cast<int*>(malloc(sizeof(int) * BATCH_TASKS));
+  for (ii = 0; ii < BATCH_TASKS; ii++) {
+    args[ii] = ii;
+    results[ii] = -1;
+  }
+
+  /* wait for the tasks of the batch one by one */
+  status = MTAPI_ERR_UNKNOWN;
+  started = mtapi_task_start_batch(
+    job,
+    args,
+    sizeof(int),
+    results,
+    sizeof(int),
+    MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE,
+    BATCH_TASKS,
+    task,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(started, static_cast<mtapi_uint_t>(BATCH_TASKS));
+
+  for (ii = 0; ii < BATCH_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_wait(task[ii], MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+    PT_EXPECT_EQ(results[ii], 2 * ii);
+  }
+
+  /* wait for the whole batch using a group */
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (ii = 0; ii < BATCH_TASKS; ii++) {
+    results[ii] = -1;
+  }
+  status = MTAPI_ERR_UNKNOWN;
+  started = mtapi_task_start_batch(
+    job,
+    args,
+    sizeof(int),
+    results,
+    sizeof(int),
+    MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    group,
+    BATCH_TASKS,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(started, static_cast<mtapi_uint_t>(BATCH_TASKS));
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  for (ii = 0; ii < BATCH_TASKS; ii++) {
+    PT_EXPECT_EQ(results[ii], 2 * ii);
+  }
+
+  free(results);
+  free(args);
+  free(task);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void TaskTest::TestMultiInstance() {
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_task_attributes_t task_attr;
+  mtapi_task_hndl_t task;
+  mtapi_group_hndl_t group;
+  mtapi_uint_t results[TASK_INSTANCES];
+  mtapi_uint_t batch_results[BATCH_INSTANCE_TASKS * TASK_INSTANCES];
+  mtapi_uint_t started;
+  mtapi_uint_t ii;
+
+  embb_mtapi_log_info("running testMultiInstance...\n");
+
+  embb_atomic_store_int(&instance_count, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(
+    THIS_DOMAIN_ID,
+    THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(
+    JOB_TEST_TASK,
+    testTaskInstanceAction,
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_taskattr_init(&task_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_taskattr_set(
+    &task_attr,
+    MTAPI_TASK_INSTANCES,
+    MTAPI_ATTRIBUTE_VALUE(TASK_INSTANCES),
+    MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* each instance writes its number into its part of the result buffer */
+  for (ii = 0; ii < TASK_INSTANCES; ii++) {
+    results[ii] = TASK_INSTANCES;
+  }
+  status = MTAPI_ERR_UNKNOWN;
+  task = mtapi_task_start(
+    MTAPI_TASK_ID_NONE,
+    job,
+    MTAPI_NULL,
+    0,
+    results,
+    sizeof(results[0]),
+    &task_attr,
+    MTAPI_GROUP_NONE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(embb_atomic_load_int(&instance_count), TASK_INSTANCES);
+  for (ii = 0; ii < TASK_INSTANCES; ii++) {
+    PT_EXPECT_EQ(results[ii], ii);
+  }
+
+  /* the group is notified once, after all instances are done */
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_start(
+    MTAPI_TASK_ID_NONE,
+    job,
+    MTAPI_NULL,
+    0,
+    MTAPI_NULL,
+    0,
+    &task_attr,
+    group,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(embb_atomic_load_int(&instance_count), 2 * TASK_INSTANCES);
+
+  /* the tasks of a batch get one result per instance each */
+  for (ii = 0; ii < BATCH_INSTANCE_TASKS * TASK_INSTANCES; ii++) {
+    batch_results[ii] = TASK_INSTANCES;
+  }
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  started = mtapi_task_start_batch(
+    job,
+    MTAPI_NULL,
+    0,
+    batch_results,
+    sizeof(batch_results[0]),
+    &task_attr,
+    group,
+    BATCH_INSTANCE_TASKS,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(started, static_cast<mtapi_uint_t>(BATCH_INSTANCE_TASKS));
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(embb_atomic_load_int(&instance_count),
+    (2 + BATCH_INSTANCE_TASKS) * TASK_INSTANCES);
+  for (ii = 0; ii < BATCH_INSTANCE_TASKS * TASK_INSTANCES; ii++) {
+    PT_EXPECT_EQ(batch_results[ii], ii % TASK_INSTANCES);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void TaskTest::TestLoadBalancing() {
+  mtapi_status_t status;
+  mtapi_action_hndl_t action[2];
+  embb_atomic_int counter[2];
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_uint_t ii;
+
+  embb_mtapi_log_info("running testLoadBalancing...\n");
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(
+    THIS_DOMAIN_ID,
+    THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* two implementations of the same job, each counting its calls */
+  for (ii = 0; ii < 2; ii++) {
+    embb_atomic_store_int(&counter[ii], 0);
+    status = MTAPI_ERR_UNKNOWN;
+    action[ii] = mtapi_action_create(
+      JOB_TEST_TASK,
+      testTaskCountingAction,
+      &counter[ii],
+      sizeof(counter[ii]),
+      MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (ii = 0; ii < BATCH_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      job,
+      MTAPI_NULL,
+      0,
+      MTAPI_NULL,
+      0,
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      group,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* every task ran exactly once and both actions got some of them */
+  PT_EXPECT_EQ(embb_atomic_load_int(&counter[0]) +
+    embb_atomic_load_int(&counter[1]), BATCH_TASKS);
+  PT_EXPECT(0 < embb_atomic_load_int(&counter[0]));
+  PT_EXPECT(0 < embb_atomic_load_int(&counter[1]));
+
+  for (ii = 0; ii < 2; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_action_delete(action[ii], MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void TaskTest::TestCancel() {
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_task_hndl_t task;
+
+  embb_mtapi_log_info("running testCancel...\n");
+
+  embb_atomic_store_int(&cancel_started, 0);
+  embb_atomic_store_int(&cancel_returned, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(
+    THIS_DOMAIN_ID,
+    THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(
+    JOB_TEST_TASK,
+    testTaskCancelledAction,
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  task = mtapi_task_start(
+    TASK_TEST_ID,
+    job,
+    MTAPI_NULL,
+    0,
+    MTAPI_NULL,
+    0,
+    MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  while (0 == embb_atomic_load_int(&cancel_started)) {
+    embb_thread_yield();
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_cancel(task, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* the wait reports the cancellation once the action has returned */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  PT_EXPECT_EQ(status, MTAPI_ERR_ACTION_CANCELLED);
+  PT_EXPECT_EQ(embb_atomic_load_int(&cancel_returned), 1);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_mtapi_log_info("...done\n\n");
+}
@@ -35,6 +35,12 @@ class TaskTest : public partest::TestCase {
 
  private:
   void TestBasic();
+  void TestLargePool();
+  void TestBlockingWait();
+  void TestStartBatch();
+  void TestMultiInstance();
+  void TestLoadBalancing();
+  void TestCancel();
 };
 
 #endif // MTAPI_C_TEST_EMBB_MTAPI_TEST_TASK_H_
@@ -34,6 +34,7 @@
 #include <embb_mtapi_test_task.h>
 #include <embb_mtapi_test_group.h>
 #include <embb_mtapi_test_queue.h>
+#include <embb_mtapi_test_scheduler.h>
 
 PT_MAIN("MTAPI C") {
   embb_log_set_log_level(EMBB_LOG_LEVEL_NONE);
@@ -42,4 +43,5 @@ PT_MAIN("MTAPI C") {
   PT_RUN(TaskTest);
   PT_RUN(GroupTest);
   PT_RUN(QueueTest);
+  PT_RUN(SchedulerTest);
 }
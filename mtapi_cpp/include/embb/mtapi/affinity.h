@@ -84,6 +84,8 @@ class Affinity {
     );
 
   friend class Task;
+  friend class Continuation;
+  friend class TaskGraph;
 
  private:
   mtapi_affinity_t affinity_;
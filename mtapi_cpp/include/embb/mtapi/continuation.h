@@ -27,6 +27,7 @@
 #ifndef EMBB_MTAPI_CONTINUATION_H_
 #define EMBB_MTAPI_CONTINUATION_H_
 
+#include <vector>
 #include <embb/mtapi/c/mtapi.h>
 #include <embb/mtapi/taskcontext.h>
 #include <embb/mtapi/action.h>
@@ -35,17 +36,17 @@
 namespace embb {
 namespace mtapi {
 
-/**
-  *  Helper struct for Continuation.
-  *
-  *  \ingroup CPP_MTAPI
-  */
-struct ContinuationStage;
-
 /**
   * A Continuation encapsulates a chain of \link Action Actions \endlink to be
   * executed consecutively.
   *
+  * Each Action runs as a Task of its own that is started as soon as the Task
+  * of the previous Action has finished, no Task waits for another one.
+  *
+  * All Tasks of the chain are created when it is spawned, so a chain cannot
+  * have more Actions than the Node has free \link Task Tasks \endlink
+  * (see the \c max_tasks parameter of Node::Initialize()).
+  *
   * \ingroup CPP_MTAPI
   */
 class Continuation {
@@ -75,14 +76,22 @@ class Continuation {
   /**
     * Runs the Continuation chain.
     * \returns The Task representing the Continuation chain.
+    * \throws ErrorException if the chain could not be started, e.g. because
+    *         it has more Actions than there are free Tasks. The Actions
+    *         that were started run to completion first.
     * \notthreadsafe
+    * \memory Allocates one block holding copies of all Actions.
     */
   Task Spawn();
 
   /**
     * Runs the Continuation chain with the specified priority.
     * \returns The Task representing the Continuation chain.
+    * \throws ErrorException if the chain could not be started, e.g. because
+    *         it has more Actions than there are free Tasks. The Actions
+    *         that were started run to completion first.
     * \notthreadsafe
+    * \memory Allocates one block holding copies of all Actions.
     */
   Task Spawn(
     mtapi_uint_t priority              /**< [in] The priority to use */
@@ -93,12 +102,7 @@ class Continuation {
  private:
   explicit Continuation(Action action);
 
-  void ExecuteContinuation(TaskContext & context);
-
-  ContinuationStage * first_;
-  ContinuationStage * last_;
-
-  mtapi_uint_t priority_;
+  std::vector<Action> stages_;
 };
 
 } // namespace mtapi
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef EMBB_MTAPI_FUTURE_H_
+#define EMBB_MTAPI_FUTURE_H_
+
+#include <cstddef>
+#include <new>
+#include <embb/base/memory_allocation.h>
+#include <embb/base/exceptions.h>
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/mtapi/taskcontext.h>
+
+namespace embb {
+namespace mtapi {
+
+namespace internal {
+
+/**
+  * Types the storage of the MTAPI task is aligned for.
+  */
+union FutureMaxAlign {
+  double align_double;
+  long long align_long_long;
+  void * align_pointer;
+};
+
+/**
+  * Alignment of \c Type, given by the padding needed in front of it.
+  */
+template <typename Type>
+struct FutureAlignment {
+  struct Padded {
+    char pad;
+    Type value;
+  };
+  static const size_t value = sizeof(Padded) - sizeof(Type);
+};
+
+/**
+  * Layout of a result that is too large for the storage of the MTAPI task
+  * or needs a stricter alignment, the task only keeps a pointer to it.
+  */
+template <typename Type, bool Inline>
+struct FutureStorage {
+  static void Construct(void * buffer, Type const & value) {
+    static_cast<FutureStorage*>(buffer)->value =
+      embb::base::Allocation::New<Type>(value);
+  }
+
+  void Destroy() {
+    embb::base::Allocation::Delete(value);
+  }
+
+  Type * value;
+};
+
+/**
+  * Layout of a result that is kept in the storage of the MTAPI task itself.
+  */
+template <typename Type>
+struct FutureStorage<Type, true> {
+  static void Construct(void * buffer, Type const & value) {
+    FutureStorage * storage = static_cast<FutureStorage*>(buffer);
+    storage->value = new (storage->data.bytes) Type(value);
+  }
+
+  void Destroy() {
+    value->~Type();
+  }
+
+  // points to data once the result has been constructed
+  Type * value;
+  union {
+    char bytes[sizeof(Type)];
+    FutureMaxAlign align;
+  } data;
+};
+
+} // namespace internal
+
+/**
+  * A Future represents a running function that returns a value of type
+  * \c Type. The value is kept by the MTAPI task until Get() is called, so
+  * no shared state has to be allocated.
+  *
+  * Like a Task, a Future may be copied, but only one copy may call Get().
+  *
+  * \see Node::Spawn()
+  * \ingroup CPP_MTAPI
+  */
+template <typename Type>
+class Future {
+ public:
+  /**
+    * Constructs an empty Future.
+    */
+  Future() {
+    handle_.id = 0;
+    handle_.tag = 0;
+  }
+
+  /**
+    * Copies a Future.
+    */
+  Future(
+    Future const & future              /**< The Future to copy. */
+    )
+    : handle_(future.handle_) {
+    // empty
+  }
+
+  /**
+    * Waits for the function to finish for \c timeout milliseconds without
+    * retrieving its value.
+    * \return The status of the finished function, \c MTAPI_TIMEOUT or
+    * \c MTAPI_ERR_*
+    * \threadsafe
+    */
+  mtapi_status_t Wait(
+    mtapi_timeout_t timeout            /**< [in] Timeout duration in
+                                            milliseconds */
+    ) {
+    mtapi_status_t status;
+    mtapi_task_get_result(handle_, timeout, &status);
+    return status;
+  }
+
+  /**
+    * Waits for the function to finish and returns its value. If called from
+    * within a Task, other Tasks are executed while waiting. Afterwards the
+    * Future is empty.
+    * \return The value returned by the function
+    * \throws ErrorException if the Future is empty or the function was
+    *         cancelled or failed.
+    * \threadsafe
+    */
+  Type Get() {
+    mtapi_status_t status;
+    Storage * storage = static_cast<Storage*>(
+      mtapi_task_get_result(handle_, MTAPI_INFINITE, &status));
+    if (MTAPI_NULL == storage) {
+      EMBB_THROW(embb::base::ErrorException,
+        "mtapi::Future does not refer to a task");
+    }
+    if (MTAPI_NULL == storage->value || MTAPI_SUCCESS != status) {
+      // a function cancelled while running may have returned anyway
+      if (MTAPI_NULL != storage->value) {
+        storage->Destroy();
+      }
+      Release();
+      EMBB_THROW(embb::base::ErrorException,
+        "mtapi::Future did not produce a value");
+    }
+    Type result(*storage->value);
+    storage->Destroy();
+    Release();
+    return result;
+  }
+
+  /**
+    * Signals the function to cancel computation. A function that is
+    * already running is still waited for by Wait() and Get().
+    * \waitfree
+    */
+  void Cancel() {
+    mtapi_status_t status;
+    mtapi_task_cancel(handle_, &status);
+  }
+
+  friend class Node;
+
+ private:
+  typedef internal::FutureStorage<Type,
+    (sizeof(internal::FutureStorage<Type, true>) <=
+      MTAPI_TASK_RESULT_INLINE_SIZE) &&
+    (internal::FutureAlignment<Type>::value <=
+      internal::FutureAlignment<internal::FutureMaxAlign>::value)> Storage;
+
+  /**
+    * Wraps a function returning \c Type into an Action.
+    */
+  template <typename Function>
+  class Producer {
+   public:
+    explicit Producer(Function function)
+      : function_(function) {
+      // empty
+    }
+
+    void operator() (TaskContext & context) {
+      Storage::Construct(GetResultBuffer(context), function_(context));
+    }
+
+   private:
+    Function function_;
+  };
+
+  explicit Future(mtapi_task_hndl_t handle)
+    : handle_(handle) {
+    // empty
+  }
+
+  static void * GetResultBuffer(TaskContext & context) {
+    return context.result_buffer_;
+  }
+
+  void Release() {
+    // the task has finished, so this only hands it back to the pool
+    mtapi_status_t status;
+    mtapi_task_wait(handle_, MTAPI_NOWAIT, &status);
+    handle_.id = 0;
+    handle_.tag = 0;
+  }
+
+  mtapi_task_hndl_t handle_;
+};
+
+} // namespace mtapi
+} // namespace embb
+
+#endif // EMBB_MTAPI_FUTURE_H_
@@ -95,6 +95,42 @@ class Group {
     mtapi_uint_t priority              /**< [in] The priority to use */
     );
 
+  /**
+    * Runs \c count Actions within the Group at once. All Tasks use the
+    * Affinity of the first Action.
+    * \throws ErrorException if not all Tasks could be started. The Tasks
+    *         that were started keep running.
+    * \threadsafe
+    * \memory Allocates one block holding copies of all Actions.
+    * \see Node::Spawn(Action const *, mtapi_uint_t, Task *)
+    */
+  void Spawn(
+    Action const * actions,            /**< [in] Array of \c count Actions
+                                            to run */
+    mtapi_uint_t count,                /**< [in] Number of Actions */
+    Task * tasks                       /**< [out] Array of \c count Tasks
+                                            identifying the Actions, may be
+                                            \c NULL */
+    );
+
+  /**
+    * Runs \c count Actions within the Group at once with the specified
+    * priority.
+    * \throws ErrorException if not all Tasks could be started. The Tasks
+    *         that were started keep running.
+    * \threadsafe
+    * \memory Allocates one block holding copies of all Actions.
+    */
+  void Spawn(
+    Action const * actions,            /**< [in] Array of \c count Actions
+                                            to run */
+    mtapi_uint_t count,                /**< [in] Number of Actions */
+    Task * tasks,                      /**< [out] Array of \c count Tasks
+                                            identifying the Actions, may be
+                                            \c NULL */
+    mtapi_uint_t priority              /**< [in] The priority to use */
+    );
+
   /**
     * Waits for any Task in the Group to finish for \c timeout milliseconds.
     * \return The status of the Task that finished execution
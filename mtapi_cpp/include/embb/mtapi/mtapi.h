@@ -36,6 +36,8 @@
  */
 
 #define MTAPI_CPP_TASK_JOB 1
+#define MTAPI_CPP_TASK_BATCH_JOB 2
+#define MTAPI_CPP_TASK_GRAPH_JOB 3
 #define MTAPI_CPP_AUTOMATIC_INITIALIZE 1
 #if MTAPI_CPP_AUTOMATIC_INITIALIZE
 #define MTAPI_CPP_AUTOMATIC_DOMAIN_ID 1
@@ -45,10 +47,12 @@
 #include <embb/mtapi/action.h>
 #include <embb/mtapi/affinity.h>
 #include <embb/mtapi/continuation.h>
+#include <embb/mtapi/future.h>
 #include <embb/mtapi/group.h>
 #include <embb/mtapi/node.h>
 #include <embb/mtapi/queue.h>
 #include <embb/mtapi/task.h>
 #include <embb/mtapi/taskcontext.h>
+#include <embb/mtapi/taskgraph.h>
 
 #endif // EMBB_MTAPI_MTAPI_H_
@@ -32,6 +32,7 @@
 #include <embb/mtapi/c/mtapi.h>
 #include <embb/mtapi/action.h>
 #include <embb/mtapi/task.h>
+#include <embb/mtapi/future.h>
 #include <embb/mtapi/continuation.h>
 #include <embb/mtapi/group.h>
 #include <embb/mtapi/queue.h>
@@ -46,6 +47,8 @@ class Allocation;
 
 namespace mtapi {
 
+class ActionPool;
+
 /**
   * A singleton representing the MTAPI runtime.
   *
@@ -121,6 +124,17 @@ class Node {
     return core_count_;
   }
 
+  /**
+    * Returns the maximum number of concurrent \link Task Tasks \endlink.
+    * Storage for tasks is allocated on demand, so a large limit does not
+    * cost memory up front.
+    * \return The maximum number of concurrent \link Task Tasks \endlink
+    * \waitfree
+    */
+  mtapi_uint_t GetTaskLimit() const {
+    return task_limit_;
+  }
+
   /**
     * Creates a Group to launch \link Task Tasks \endlink in.
     * \return A reference to the created Group
@@ -184,6 +198,78 @@ class Node {
     mtapi_uint_t priority              /**< [in] The priority to use */
     );
 
+  /**
+    * Runs a function returning a value of type \c Type.
+    * \return A Future providing the value once the function has finished
+    * \throws ErrorException if the Future object could not be constructed.
+    * \threadsafe
+    * \tparam Type Type of the value returned by the function
+    * \tparam Function Anything that provides a
+    *         <tt>Type operator() (TaskContext &)</tt>
+    */
+  template <typename Type, typename Function>
+  Future<Type> Spawn(
+    Function function                  /**< [in] The function to execute */
+    ) {
+    return Spawn<Type>(function, 0);
+  }
+
+  /**
+    * Runs a function returning a value of type \c Type with the specified
+    * priority.
+    * \return A Future providing the value once the function has finished
+    * \throws ErrorException if the Future object could not be constructed.
+    * \threadsafe
+    * \tparam Type Type of the value returned by the function
+    * \tparam Function Anything that provides a
+    *         <tt>Type operator() (TaskContext &)</tt>
+    */
+  template <typename Type, typename Function>
+  Future<Type> Spawn(
+    Function function,                 /**< [in] The function to execute */
+    mtapi_uint_t priority              /**< [in] The priority to use */
+    ) {
+    typedef typename Future<Type>::template Producer<Function> Producer;
+    return Future<Type>(Start(Action(Producer(function)),
+      sizeof(typename Future<Type>::Storage), priority));
+  }
+
+  /**
+    * Runs \c count Actions at once. Compared to \c count calls of Spawn(),
+    * the Tasks are distributed among the worker threads in a single pass.
+    * All Tasks use the Affinity of the first Action.
+    * \throws ErrorException if not all Tasks could be started. The Tasks
+    *         that were started keep running.
+    * \threadsafe
+    * \memory Allocates one block holding copies of all Actions.
+    */
+  void Spawn(
+    Action const * actions,            /**< [in] Array of \c count Actions
+                                            to execute */
+    mtapi_uint_t count,                /**< [in] Number of Actions */
+    Task * tasks                       /**< [out] Array of \c count Tasks
+                                            identifying the Actions, may be
+                                            \c NULL */
+    );
+
+  /**
+    * Runs \c count Actions at once with the specified priority.
+    * \throws ErrorException if not all Tasks could be started. The Tasks
+    *         that were started keep running.
+    * \threadsafe
+    * \memory Allocates one block holding copies of all Actions.
+    * \see Spawn(Action const *, mtapi_uint_t, Task *)
+    */
+  void Spawn(
+    Action const * actions,            /**< [in] Array of \c count Actions
+                                            to execute */
+    mtapi_uint_t count,                /**< [in] Number of Actions */
+    Task * tasks,                      /**< [out] Array of \c count Tasks
+                                            identifying the Actions, may be
+                                            \c NULL */
+    mtapi_uint_t priority              /**< [in] The priority to use */
+    );
+
   /**
     * Creates a Continuation.
     * \return A Continuation chain
@@ -195,6 +281,9 @@ class Node {
     );
 
   friend class embb::base::Allocation;
+  friend class Task;
+  friend class Continuation;
+  friend class TaskGraph;
 
  private:
   Node(Node const & node);
@@ -204,6 +293,17 @@ class Node {
     mtapi_node_attributes_t * attr);
   ~Node();
 
+  /**
+    * Returns the singleton without locking, for use on the spawn paths
+    * where the Node is known to be initialized.
+    */
+  static Node & GetCurrent();
+
+  mtapi_task_hndl_t Start(
+    Action const & action,
+    mtapi_size_t result_size,
+    mtapi_uint_t priority);
+
   static void action_func(
     const void* args,
     mtapi_size_t args_size,
@@ -213,8 +313,29 @@ class Node {
     mtapi_size_t node_local_data_size,
     mtapi_task_context_t * context);
 
+  static Action * AllocateAction(Action const & action);
+
+  static void FreeAction(Action * action);
+
+  static void batch_action_func(
+    const void* args,
+    mtapi_size_t args_size,
+    void* result_buffer,
+    mtapi_size_t result_buffer_size,
+    const void* node_local_data,
+    mtapi_size_t node_local_data_size,
+    mtapi_task_context_t * context);
+
   mtapi_uint_t core_count_;
+  mtapi_uint_t task_limit_;
   mtapi_action_hndl_t action_handle_;
+  mtapi_action_hndl_t batch_action_handle_;
+  mtapi_action_hndl_t graph_action_handle_;
+  mtapi_job_hndl_t job_handle_;
+  mtapi_job_hndl_t batch_job_handle_;
+  mtapi_job_hndl_t graph_job_handle_;
+  mtapi_task_attributes_t task_attributes_;
+  ActionPool * action_pool_;
   std::list<Queue*> queues_;
   std::list<Group*> groups_;
 };
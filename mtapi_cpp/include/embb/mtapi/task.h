@@ -77,6 +77,8 @@ class Task {
   friend class Group;
   friend class Queue;
   friend class Node;
+  friend class Continuation;
+  friend class TaskGraph;
 
  private:
   Task(
@@ -113,6 +115,18 @@ class Task {
     mtapi_group_hndl_t group,
     mtapi_uint_t priority);
 
+  static void Start(
+    Action const * actions,
+    mtapi_uint_t count,
+    mtapi_group_hndl_t group,
+    mtapi_uint_t priority,
+    Task * tasks);
+
+  static void SetAttributes(
+    Action const & action,
+    mtapi_uint_t priority,
+    mtapi_task_attributes_t & attr);
+
   mtapi_task_hndl_t handle_;
 };
 
@@ -65,11 +65,18 @@ class TaskContext {
     );
 
   friend class Node;
+  friend class TaskGraph;
+  template <typename Type> friend class Future;
 
  private:
   explicit TaskContext(mtapi_task_context_t * task_context);
 
+  TaskContext(
+    mtapi_task_context_t * task_context,
+    void * result_buffer);
+
   mtapi_task_context_t * context_;
+  void * result_buffer_;
 };
 
 } // namespace mtapi
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_MTAPI_TASKGRAPH_H_
+#define EMBB_MTAPI_TASKGRAPH_H_
+
+#include <vector>
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/mtapi/taskcontext.h>
+#include <embb/mtapi/action.h>
+
+namespace embb {
+namespace mtapi {
+
+/**
+  *  Helper struct for TaskGraph.
+  *
+  *  \ingroup CPP_MTAPI
+  */
+struct TaskGraphVertex;
+
+/**
+  * A TaskGraph encapsulates \link Action Actions \endlink with dependencies
+  * between them, forming a directed acyclic graph.
+  *
+  * Each Action runs as a Task as soon as all of its predecessors have
+  * finished. The Task of the last predecessor to finish starts it, so no
+  * thread blocks while the graph is running, except for the one calling
+  * Wait(). The graph can be spawned again once Wait() has returned,
+  * without allocating memory.
+  *
+  * \ingroup CPP_MTAPI
+  */
+class TaskGraph {
+ public:
+  /**
+    * Identifies a vertex of the graph.
+    */
+  typedef mtapi_uint_t VertexId;
+
+  /**
+    * Constructs an empty graph.
+    */
+  TaskGraph();
+
+  /**
+    * Destructor.
+    * \pre The graph is not running.
+    */
+  ~TaskGraph();
+
+  /**
+    * Adds an Action to the graph. It runs as soon as the Actions given to
+    * Precede() for it have finished, or right away if there are none.
+    * \returns The id of the new vertex.
+    * \notthreadsafe
+    * \memory Allocates the vertex.
+    */
+  VertexId Add(
+    Action action                      /**< [in] The Action to add */
+    );
+
+  /**
+    * Makes the vertex \c after wait until the vertex \c before has
+    * finished.
+    * \throws ErrorException if a vertex is invalid or \c before equals
+    *         \c after.
+    * \notthreadsafe
+    */
+  void Precede(
+    VertexId before,                   /**< [in] Vertex to run first */
+    VertexId after                     /**< [in] Vertex to run afterwards */
+    );
+
+  /**
+    * Runs the graph.
+    * \throws ErrorException if the graph is running already, contains a
+    *         cycle or its Tasks could not be started.
+    * \notthreadsafe
+    */
+  void Spawn();
+
+  /**
+    * Runs the graph with the specified priority.
+    * \throws ErrorException if the graph is running already, contains a
+    *         cycle or its Tasks could not be started.
+    * \notthreadsafe
+    */
+  void Spawn(
+    mtapi_uint_t priority              /**< [in] The priority to use */
+    );
+
+  /**
+    * Waits for all Actions of the graph to finish. The calling thread
+    * executes other Tasks meanwhile.
+    * \returns \c MTAPI_SUCCESS, \c MTAPI_TIMEOUT or the error of a Task
+    *          that failed.
+    * \notthreadsafe
+    */
+  mtapi_status_t Wait(
+    mtapi_timeout_t timeout            /**< [in] Timeout duration in
+                                            milliseconds */
+    );
+
+  friend class Node;
+
+ private:
+  TaskGraph(TaskGraph const & graph);
+  TaskGraph & operator=(TaskGraph const & graph);
+
+  void Validate();
+
+  static bool Start(TaskGraphVertex * vertex);
+
+  static void Run(TaskGraphVertex * vertex, mtapi_task_context_t * context);
+
+  static void action_func(
+    const void* args,
+    mtapi_size_t args_size,
+    void* result_buffer,
+    mtapi_size_t result_buffer_size,
+    const void* node_local_data,
+    mtapi_size_t node_local_data_size,
+    mtapi_task_context_t * context);
+
+  std::vector<TaskGraphVertex*> vertices_;
+  std::vector<TaskGraphVertex*> roots_;
+  bool validated_;
+  bool running_;
+
+  mtapi_group_hndl_t group_;
+};
+
+} // namespace mtapi
+} // namespace embb
+
+#endif // EMBB_MTAPI_TASKGRAPH_H_
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <new>
+
+#include <embb/base/memory_allocation.h>
+#include <embb/mtapi/mtapi.h>
+
+#include <actionpool.h>
+
+namespace embb {
+namespace mtapi {
+
+ActionPool::ActionPool(mtapi_uint_t capacity)
+  : capacity_(capacity)
+  , get_position_(0)
+  , put_position_(0) {
+  // the queue needs a power of 2 size, so positions may wrap around
+  mtapi_uint_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  mask_ = size - 1;
+  cells_ = static_cast<Cell*>(
+    embb::base::Allocation::Allocate(size * sizeof(Cell)));
+  actions_ = static_cast<Action*>(
+    embb::base::Allocation::Allocate(capacity * sizeof(Action)));
+  // all slots start out free
+  for (mtapi_uint_t ii = 0; ii < size; ii++) {
+    new (&cells_[ii]) Cell;
+    cells_[ii].index = ii;
+    cells_[ii].sequence = (ii < capacity) ? ii + 1 : ii;
+  }
+  put_position_ = capacity;
+}
+
+ActionPool::~ActionPool() {
+  for (mtapi_uint_t ii = 0; ii <= mask_; ii++) {
+    cells_[ii].~Cell();
+  }
+  embb::base::Allocation::Free(actions_);
+  embb::base::Allocation::Free(cells_);
+}
+
+Action * ActionPool::Allocate(Action const & action) {
+  mtapi_uint_t index;
+  if (TryGetIndex(index)) {
+    return new (&actions_[index]) Action(action);
+  }
+  return embb::base::Allocation::New<Action>(action);
+}
+
+void ActionPool::Free(Action * action) {
+  if (action >= actions_ && action < actions_ + capacity_) {
+    action->~Action();
+    PutIndex(static_cast<mtapi_uint_t>(action - actions_));
+  } else {
+    embb::base::Allocation::Delete(action);
+  }
+}
+
+bool ActionPool::TryGetIndex(mtapi_uint_t & index) {
+  mtapi_uint_t position = get_position_.Load();
+  for (;;) {
+    Cell & cell = cells_[position & mask_];
+    int difference = static_cast<int>(cell.sequence.Load() - (position + 1));
+    if (0 == difference) {
+      // cell holds a free index, try to claim it
+      if (get_position_.CompareAndSwap(position, position + 1)) {
+        index = cell.index;
+        cell.sequence = position + mask_ + 1;
+        return true;
+      }
+      // position was updated by the failed compare and swap
+    } else if (0 > difference) {
+      // no free slot left
+      return false;
+    } else {
+      position = get_position_.Load();
+    }
+  }
+}
+
+void ActionPool::PutIndex(mtapi_uint_t index) {
+  mtapi_uint_t position = put_position_.Load();
+  for (;;) {
+    Cell & cell = cells_[position & mask_];
+    int difference = static_cast<int>(cell.sequence.Load() - position);
+    if (0 == difference) {
+      if (put_position_.CompareAndSwap(position, position + 1)) {
+        cell.index = index;
+        cell.sequence = position + 1;
+        return;
+      }
+    } else {
+      // there are never more indices than cells, so the cell is about to
+      // be emptied by another thread
+      position = put_position_.Load();
+    }
+  }
+}
+
+} // namespace mtapi
+} // namespace embb
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MTAPI_CPP_SRC_ACTIONPOOL_H_
+#define MTAPI_CPP_SRC_ACTIONPOOL_H_
+
+#include <embb/base/atomic.h>
+#include <embb/mtapi/mtapi.h>
+
+namespace embb {
+namespace mtapi {
+
+/**
+ * Preallocated storage for the copies of the \link Action Actions \endlink
+ * that single \link Task Tasks \endlink run. There is room for as many
+ * Actions as there can be Tasks, so starting a Task does not allocate.
+ * Free slots are kept in a bounded lock-free queue of indices.
+ */
+class ActionPool {
+ public:
+  explicit ActionPool(mtapi_uint_t capacity);
+  ~ActionPool();
+
+  /**
+   * Returns a copy of \c action, taken from the heap if the pool is empty.
+   * \threadsafe
+   */
+  Action * Allocate(Action const & action);
+
+  /**
+   * Destroys an Action returned by Allocate().
+   * \threadsafe
+   */
+  void Free(Action * action);
+
+ private:
+  ActionPool(ActionPool const & pool);
+  ActionPool & operator=(ActionPool const & pool);
+
+  struct Cell {
+    embb::base::Atomic<mtapi_uint_t> sequence;
+    mtapi_uint_t index;
+  };
+
+  bool TryGetIndex(mtapi_uint_t & index);
+  void PutIndex(mtapi_uint_t index);
+
+  mtapi_uint_t capacity_;
+  mtapi_uint_t mask_;
+  Cell * cells_;
+  Action * actions_;
+  embb::base::Atomic<mtapi_uint_t> get_position_;
+  embb::base::Atomic<mtapi_uint_t> put_position_;
+};
+
+} // namespace mtapi
+} // namespace embb
+
+#endif // MTAPI_CPP_SRC_ACTIONPOOL_H_
@@ -24,57 +24,30 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <cstddef>
 
-#include <embb/base/memory_allocation.h>
-#include <embb/base/function.h>
+#include <cassert>
+
+#include <embb/base/exceptions.h>
 #include <embb/mtapi/mtapi.h>
 
-#include <continuationstage.h>
+#include <taskbatch.h>
 
 namespace embb {
 namespace mtapi {
 
-Continuation::Continuation(Action action) {
-  first_ = last_ = embb::base::Allocation::New<ContinuationStage>();
-  first_->action = action;
-  first_->next = NULL;
+Continuation::Continuation(Action action)
+  : stages_(1, action) {
 }
 
 Continuation::Continuation(Continuation const & cont)
-  : first_(cont.first_)
-  , last_(cont.last_) {
+  : stages_(cont.stages_) {
 }
 
 Continuation::~Continuation() {
 }
 
-void Continuation::ExecuteContinuation(TaskContext &) {
-  mtapi::ContinuationStage * stage = first_;
-  mtapi::Node & node = mtapi::Node::GetInstance();
-  while (NULL != stage) {
-    mtapi::Task task = node.Spawn(stage->action, priority_);
-    task.Wait(MTAPI_INFINITE);
-    stage = stage->next;
-  }
-
-  // delete stages
-  stage = first_;
-  while (NULL != stage) {
-    mtapi::ContinuationStage * next = stage->next;
-    embb::base::Allocation::Delete(stage);
-    stage = next;
-  }
-}
-
 Continuation & Continuation::Then(Action action) {
-  ContinuationStage * cur = embb::base::Allocation::New<ContinuationStage>();
-  cur->action = action;
-  cur->next = NULL;
-
-  last_->next = cur;
-  last_ = cur;
-
+  stages_.push_back(action);
   return *this;
 }
 
@@ -83,11 +56,47 @@ Task Continuation::Spawn() {
 }
 
 Task Continuation::Spawn(mtapi_uint_t priority) {
-  priority_ = priority;
-  Node & node = Node::GetInstance();
-  return node.Spawn(
-    embb::base::MakeFunction(*this, &Continuation::ExecuteContinuation),
-    priority);
+  mtapi_uint_t count = static_cast<mtapi_uint_t>(stages_.size());
+  mtapi_status_t status;
+  mtapi_job_hndl_t job = Node::GetCurrent().batch_job_handle_;
+
+  // all stages live in one block that is freed after the last one ran
+  TaskBatch * batch = TaskBatchCreate(&stages_[0], count);
+  TaskBatchEntry * entries = TaskBatchGetEntries(batch);
+  Task last;
+  mtapi_uint_t started;
+  for (started = 0; started < count; started++) {
+    mtapi_task_attributes_t attr;
+    Task::SetAttributes(entries[started].action, priority, attr);
+
+    mtapi_task_hndl_t handle;
+    if (0 == started) {
+      handle = mtapi_task_start(MTAPI_TASK_ID_NONE, job,
+        &entries[started], sizeof(TaskBatchEntry), MTAPI_NULL, 0,
+        &attr, MTAPI_GROUP_NONE, &status);
+    } else {
+      // the stage is started by the previous one when it finishes
+      entries[started].predecessor = last.handle_;
+      handle = mtapi_task_continue_with(last.handle_, MTAPI_TASK_ID_NONE,
+        job, &entries[started], sizeof(TaskBatchEntry), MTAPI_NULL, 0,
+        &attr, MTAPI_GROUP_NONE, &status);
+    }
+    if (MTAPI_SUCCESS != status) {
+      break;
+    }
+    last.handle_ = handle;
+  }
+  // drop the references of the stages that did not start and our own
+  TaskBatchRelease(batch, count - started + 1);
+
+  if (started < count) {
+    if (0 < started) {
+      last.Wait(MTAPI_INFINITE);
+    }
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::Continuation could not be started");
+  }
+  return last;
 }
 
 } // namespace mtapi
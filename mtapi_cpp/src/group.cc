@@ -68,6 +68,18 @@ Task Group::Spawn(mtapi_task_id_t id, Action action, mtapi_uint_t priority) {
   return Task(id, action, handle_, priority);
 }
 
+void Group::Spawn(Action const * actions, mtapi_uint_t count, Task * tasks) {
+  Spawn(actions, count, tasks, 0);
+}
+
+void Group::Spawn(
+  Action const * actions,
+  mtapi_uint_t count,
+  Task * tasks,
+  mtapi_uint_t priority) {
+  Task::Start(actions, count, handle_, priority, tasks);
+}
+
 mtapi_status_t Group::WaitAny(mtapi_timeout_t timeout) {
   mtapi_status_t status;
   mtapi_group_wait_any(handle_, MTAPI_NULL, timeout, &status);
@@ -32,6 +32,8 @@
 #include <embb/base/memory_allocation.h>
 #include <embb/base/exceptions.h>
 #include <embb/mtapi/mtapi.h>
+#include <taskbatch.h>
+#include <actionpool.h>
 #if MTAPI_CPP_AUTOMATIC_INITIALIZE
 #include <embb/base/mutex.h>
 #endif
@@ -49,16 +51,49 @@ namespace mtapi {
 void Node::action_func(
   const void* args,
   mtapi_size_t /*args_size*/,
-  void* /*result_buffer*/,
+  void* result_buffer,
   mtapi_size_t /*result_buffer_size*/,
   const void* /*node_local_data*/,
   mtapi_size_t /*node_local_data_size*/,
   mtapi_task_context_t * context) {
   mtapi::Action * action =
     reinterpret_cast<mtapi::Action*>(const_cast<void*>(args));
-  mtapi::TaskContext task_context(context);
+  // the result buffer is only used by the Actions of Futures
+  mtapi::TaskContext task_context(context, result_buffer);
   (*action)(task_context);
-  embb::base::Allocation::Delete(action);
+  FreeAction(action);
+}
+
+Action * Node::AllocateAction(Action const & action) {
+  return node_instance->action_pool_->Allocate(action);
+}
+
+void Node::FreeAction(Action * action) {
+  node_instance->action_pool_->Free(action);
+}
+
+Node & Node::GetCurrent() {
+  return *node_instance;
+}
+
+void Node::batch_action_func(
+  const void* args,
+  mtapi_size_t /*args_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t * context) {
+  mtapi::TaskBatchEntry * entry = reinterpret_cast<mtapi::TaskBatchEntry*>(
+    const_cast<void*>(args));
+  if (0 != entry->predecessor.id) {
+    // nobody else holds the handle of a finished Continuation stage
+    mtapi_status_t status;
+    mtapi_task_wait(entry->predecessor, 0, &status);
+  }
+  mtapi::TaskContext task_context(context);
+  entry->action(task_context);
+  TaskBatchRelease(entry->batch, 1);
 }
 
 Node::Node(
@@ -73,12 +108,44 @@ Node::Node(
       "mtapi::Node could not initialize mtapi");
   }
   core_count_ = info.hardware_concurrency;
+  mtapi_node_get_attribute(node_id, MTAPI_NODE_MAX_TASKS,
+    &task_limit_, sizeof(task_limit_), &status);
+  if (MTAPI_SUCCESS != status) {
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::Node could not query the task limit");
+  }
+  // every Task may hold an Action at the same time
+  action_pool_ = embb::base::Allocation::New<ActionPool>(task_limit_);
   action_handle_ = mtapi_action_create(MTAPI_CPP_TASK_JOB, action_func,
     MTAPI_NULL, 0, MTAPI_NULL, &status);
   if (MTAPI_SUCCESS != status) {
     EMBB_THROW(embb::base::ErrorException,
       "mtapi::Node could not create an action");
   }
+  batch_action_handle_ = mtapi_action_create(MTAPI_CPP_TASK_BATCH_JOB,
+    batch_action_func, MTAPI_NULL, 0, MTAPI_NULL, &status);
+  if (MTAPI_SUCCESS != status) {
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::Node could not create an action");
+  }
+  graph_action_handle_ = mtapi_action_create(MTAPI_CPP_TASK_GRAPH_JOB,
+    TaskGraph::action_func, MTAPI_NULL, 0, MTAPI_NULL, &status);
+  if (MTAPI_SUCCESS != status) {
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::Node could not create an action");
+  }
+  // the job handles and default attributes do not change while the node
+  // exists, so they are looked up once instead of on every Task start
+  job_handle_ = mtapi_job_get(MTAPI_CPP_TASK_JOB, domain_id, &status);
+  assert(MTAPI_SUCCESS == status);
+  batch_job_handle_ =
+    mtapi_job_get(MTAPI_CPP_TASK_BATCH_JOB, domain_id, &status);
+  assert(MTAPI_SUCCESS == status);
+  graph_job_handle_ =
+    mtapi_job_get(MTAPI_CPP_TASK_GRAPH_JOB, domain_id, &status);
+  assert(MTAPI_SUCCESS == status);
+  mtapi_taskattr_init(&task_attributes_, &status);
+  assert(MTAPI_SUCCESS == status);
 }
 
 Node::~Node() {
@@ -97,10 +164,15 @@ Node::~Node() {
   groups_.clear();
 
   mtapi_status_t status;
+  mtapi_action_delete(graph_action_handle_, MTAPI_INFINITE, &status);
+  assert(MTAPI_SUCCESS == status);
+  mtapi_action_delete(batch_action_handle_, MTAPI_INFINITE, &status);
+  assert(MTAPI_SUCCESS == status);
   mtapi_action_delete(action_handle_, MTAPI_INFINITE, &status);
   assert(MTAPI_SUCCESS == status);
   mtapi_finalize(&status);
   assert(MTAPI_SUCCESS == status);
+  embb::base::Allocation::Delete(action_pool_);
 }
 
 void Node::Initialize(
@@ -152,7 +224,7 @@ void Node::Initialize(
     assert(MTAPI_SUCCESS == status);
     embb_core_set_t cs;
     embb_core_set_init(&cs, 0);
-    for (unsigned int ii = 0; ii < core_set.Count(); ii++) {
+    for (unsigned int ii = 0; ii < embb_core_count_available(); ii++) {
       if (core_set.IsContained(ii)) {
         embb_core_set_add(&cs, ii);
       }
@@ -264,6 +336,38 @@ Task Node::Spawn(Action action, mtapi_uint_t priority) {
   return Task(action, priority);
 }
 
+mtapi_task_hndl_t Node::Start(
+  Action const & action,
+  mtapi_size_t result_size,
+  mtapi_uint_t priority) {
+  mtapi_status_t status;
+  mtapi_task_attributes_t attr;
+  Task::SetAttributes(action, priority, attr);
+  Action * holder = AllocateAction(action);
+  // without a result buffer the result is kept by the task itself
+  mtapi_task_hndl_t handle = mtapi_task_start(MTAPI_TASK_ID_NONE,
+    job_handle_, holder, sizeof(Action), MTAPI_NULL, result_size, &attr,
+    MTAPI_GROUP_NONE, &status);
+  if (MTAPI_SUCCESS != status) {
+    FreeAction(holder);
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::Future could not be started");
+  }
+  return handle;
+}
+
+void Node::Spawn(Action const * actions, mtapi_uint_t count, Task * tasks) {
+  Spawn(actions, count, tasks, 0);
+}
+
+void Node::Spawn(
+  Action const * actions,
+  mtapi_uint_t count,
+  Task * tasks,
+  mtapi_uint_t priority) {
+  Task::Start(actions, count, MTAPI_GROUP_NONE, priority, tasks);
+}
+
 Continuation Node::First(Action action) {
   return Continuation(action);
 }
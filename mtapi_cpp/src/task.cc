@@ -31,6 +31,8 @@
 #include <embb/base/exceptions.h>
 #include <embb/mtapi/mtapi.h>
 
+#include <taskbatch.h>
+
 namespace embb {
 namespace mtapi {
 
@@ -44,28 +46,29 @@ Task::Task(Task const & task)
   // empty
 }
 
+void Task::SetAttributes(
+  Action const & action,
+  mtapi_uint_t priority,
+  mtapi_task_attributes_t & attr) {
+  // copy the defaults the Node set up once; the priority and affinity
+  // are valid by construction, the priority is still checked on start
+  attr = Node::GetCurrent().task_attributes_;
+  attr.priority = priority;
+  attr.affinity = action.GetAffinity().affinity_;
+}
+
 Task::Task(
   Action action,
   mtapi_uint_t priority) {
   mtapi_status_t status;
   mtapi_task_attributes_t attr;
-  Affinity affinity = action.GetAffinity();
-  mtapi_taskattr_init(&attr, &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_PRIORITY,
-    &priority, sizeof(priority), &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_AFFINITY,
-    &affinity.affinity_, sizeof(affinity.affinity_), &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_domain_t domain_id = mtapi_domain_id_get(&status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_job_hndl_t job = mtapi_job_get(MTAPI_CPP_TASK_JOB, domain_id, &status);
-  assert(MTAPI_SUCCESS == status);
-  Action* holder = embb::base::Allocation::New<Action>(action);
+  SetAttributes(action, priority, attr);
+  mtapi_job_hndl_t job = Node::GetCurrent().job_handle_;
+  Action* holder = Node::AllocateAction(action);
   handle_ = mtapi_task_start(MTAPI_TASK_ID_NONE, job,
     holder, sizeof(Action), MTAPI_NULL, 0, &attr, MTAPI_GROUP_NONE, &status);
   if (MTAPI_SUCCESS != status) {
+    Node::FreeAction(holder);
     EMBB_THROW(embb::base::ErrorException,
       "mtapi::Task could not be started");
   }
@@ -77,23 +80,13 @@ Task::Task(
   mtapi_uint_t priority) {
   mtapi_status_t status;
   mtapi_task_attributes_t attr;
-  Affinity affinity = action.GetAffinity();
-  mtapi_taskattr_init(&attr, &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_PRIORITY,
-    &priority, sizeof(priority), &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_AFFINITY,
-    &affinity.affinity_, sizeof(affinity.affinity_), &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_domain_t domain_id = mtapi_domain_id_get(&status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_job_hndl_t job = mtapi_job_get(MTAPI_CPP_TASK_JOB, domain_id, &status);
-  assert(MTAPI_SUCCESS == status);
-  Action* holder = embb::base::Allocation::New<Action>(action);
+  SetAttributes(action, priority, attr);
+  mtapi_job_hndl_t job = Node::GetCurrent().job_handle_;
+  Action* holder = Node::AllocateAction(action);
   handle_ = mtapi_task_start(MTAPI_TASK_ID_NONE, job,
     holder, sizeof(Action), MTAPI_NULL, 0, &attr, group, &status);
   if (MTAPI_SUCCESS != status) {
+    Node::FreeAction(holder);
     EMBB_THROW(embb::base::ErrorException,
       "mtapi::Task could not be started");
   }
@@ -106,25 +99,15 @@ Task::Task(
   mtapi_uint_t priority) {
   mtapi_status_t status;
   mtapi_task_attributes_t attr;
-  Affinity affinity = action.GetAffinity();
-  mtapi_taskattr_init(&attr, &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_PRIORITY,
-    &priority, sizeof(priority), &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_AFFINITY,
-    &affinity.affinity_, sizeof(affinity.affinity_), &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_domain_t domain_id = mtapi_domain_id_get(&status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_job_hndl_t job = mtapi_job_get(MTAPI_CPP_TASK_JOB, domain_id, &status);
-  assert(MTAPI_SUCCESS == status);
-  Action* holder = embb::base::Allocation::New<Action>(action);
+  SetAttributes(action, priority, attr);
+  mtapi_job_hndl_t job = Node::GetCurrent().job_handle_;
+  Action* holder = Node::AllocateAction(action);
   void * idptr = MTAPI_NULL;
   memcpy(&idptr, &id, sizeof(id));
   handle_ = mtapi_task_start(id, job,
     holder, sizeof(Action), idptr, 0, &attr, group, &status);
   if (MTAPI_SUCCESS != status) {
+    Node::FreeAction(holder);
     EMBB_THROW(embb::base::ErrorException,
       "mtapi::Task could not be started");
   }
@@ -136,19 +119,12 @@ Task::Task(
   mtapi_uint_t priority) {
   mtapi_status_t status;
   mtapi_task_attributes_t attr;
-  Affinity affinity = action.GetAffinity();
-  mtapi_taskattr_init(&attr, &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_PRIORITY,
-    &priority, sizeof(priority), &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_AFFINITY,
-    &affinity.affinity_, sizeof(affinity.affinity_), &status);
-  assert(MTAPI_SUCCESS == status);
-  Action* holder = embb::base::Allocation::New<Action>(action);
+  SetAttributes(action, priority, attr);
+  Action* holder = Node::AllocateAction(action);
   handle_ = mtapi_task_enqueue(MTAPI_TASK_ID_NONE, queue,
     holder, sizeof(Action), MTAPI_NULL, 0, &attr, MTAPI_GROUP_NONE, &status);
   if (MTAPI_SUCCESS != status) {
+    Node::FreeAction(holder);
     EMBB_THROW(embb::base::ErrorException,
       "mtapi::Task could not be started");
   }
@@ -161,19 +137,12 @@ Task::Task(
   mtapi_uint_t priority) {
   mtapi_status_t status;
   mtapi_task_attributes_t attr;
-  Affinity affinity = action.GetAffinity();
-  mtapi_taskattr_init(&attr, &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_PRIORITY,
-    &priority, sizeof(priority), &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_AFFINITY,
-    &affinity.affinity_, sizeof(affinity.affinity_), &status);
-  assert(MTAPI_SUCCESS == status);
-  Action* holder = embb::base::Allocation::New<Action>(action);
+  SetAttributes(action, priority, attr);
+  Action* holder = Node::AllocateAction(action);
   handle_ = mtapi_task_enqueue(MTAPI_TASK_ID_NONE, queue,
     holder, sizeof(Action), MTAPI_NULL, 0, &attr, group, &status);
   if (MTAPI_SUCCESS != status) {
+    Node::FreeAction(holder);
     EMBB_THROW(embb::base::ErrorException,
       "mtapi::Task could not be started");
   }
@@ -187,20 +156,50 @@ Task::Task(
   mtapi_uint_t priority) {
   mtapi_status_t status;
   mtapi_task_attributes_t attr;
-  Affinity affinity = action.GetAffinity();
-  mtapi_taskattr_init(&attr, &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_PRIORITY,
-    &priority, sizeof(priority), &status);
-  assert(MTAPI_SUCCESS == status);
-  mtapi_taskattr_set(&attr, MTAPI_TASK_AFFINITY,
-    &affinity.affinity_, sizeof(affinity.affinity_), &status);
-  assert(MTAPI_SUCCESS == status);
-  Action* holder = embb::base::Allocation::New<Action>(action);
+  SetAttributes(action, priority, attr);
+  Action* holder = Node::AllocateAction(action);
   void * idptr = MTAPI_NULL;
   memcpy(&idptr, &id, sizeof(id));
   handle_ = mtapi_task_enqueue(id, queue,
     holder, sizeof(Action), idptr, 0, &attr, group, &status);
+  if (MTAPI_SUCCESS != status) {
+    Node::FreeAction(holder);
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::Task could not be started");
+  }
+}
+
+void Task::Start(
+  Action const * actions,
+  mtapi_uint_t count,
+  mtapi_group_hndl_t group,
+  mtapi_uint_t priority,
+  Task * tasks) {
+  if (0 == count) {
+    return;
+  }
+  mtapi_status_t status;
+  mtapi_task_attributes_t attr;
+  // the tasks of a batch share their attributes
+  SetAttributes(actions[0], priority, attr);
+  mtapi_job_hndl_t job = Node::GetCurrent().batch_job_handle_;
+  TaskBatch * batch = TaskBatchCreate(actions, count);
+  mtapi_task_hndl_t * handles = MTAPI_NULL;
+  if (MTAPI_NULL != tasks) {
+    handles = static_cast<mtapi_task_hndl_t*>(
+      embb::base::Allocation::Allocate(count * sizeof(mtapi_task_hndl_t)));
+  }
+  mtapi_uint_t started = mtapi_task_start_batch(job,
+    TaskBatchGetEntries(batch), sizeof(TaskBatchEntry), MTAPI_NULL, 0,
+    &attr, group, count, handles, &status);
+  if (MTAPI_NULL != handles) {
+    for (mtapi_uint_t ii = 0; ii < count; ii++) {
+      tasks[ii].handle_ = handles[ii];
+    }
+    embb::base::Allocation::Free(handles);
+  }
+  // drop the references of the tasks that did not start and our own
+  TaskBatchRelease(batch, count - started + 1);
   if (MTAPI_SUCCESS != status) {
     EMBB_THROW(embb::base::ErrorException,
       "mtapi::Task could not be started");
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <new>
+
+#include <embb/base/memory_allocation.h>
+#include <embb/base/exceptions.h>
+#include <embb/mtapi/mtapi.h>
+
+#include <taskbatch.h>
+
+namespace embb {
+namespace mtapi {
+
+namespace {
+
+// the entries follow the header, rounded up so that they stay aligned
+size_t TaskBatchGetHeaderSize() {
+  return ((sizeof(TaskBatch) + sizeof(TaskBatchEntry) - 1) /
+    sizeof(TaskBatchEntry)) * sizeof(TaskBatchEntry);
+}
+
+} // namespace
+
+TaskBatch * TaskBatchCreate(Action const * actions, mtapi_uint_t count) {
+  void * memory = embb::base::Allocation::Allocate(
+    TaskBatchGetHeaderSize() + count * sizeof(TaskBatchEntry));
+  TaskBatch * batch = new (memory) TaskBatch;
+  batch->references = count + 1;
+  batch->count = count;
+  TaskBatchEntry * entries = TaskBatchGetEntries(batch);
+  for (mtapi_uint_t ii = 0; ii < count; ii++) {
+    new (&entries[ii]) TaskBatchEntry(actions[ii], batch);
+  }
+  return batch;
+}
+
+TaskBatchEntry * TaskBatchGetEntries(TaskBatch * batch) {
+  return reinterpret_cast<TaskBatchEntry*>(
+    reinterpret_cast<char*>(batch) + TaskBatchGetHeaderSize());
+}
+
+void TaskBatchRelease(TaskBatch * batch, mtapi_uint_t references) {
+  if (batch->references.FetchAndSub(references) == references) {
+    TaskBatchEntry * entries = TaskBatchGetEntries(batch);
+    for (mtapi_uint_t ii = 0; ii < batch->count; ii++) {
+      entries[ii].~TaskBatchEntry();
+    }
+    batch->~TaskBatch();
+    embb::base::Allocation::Free(batch);
+  }
+}
+
+} // namespace mtapi
+} // namespace embb
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MTAPI_CPP_SRC_TASKBATCH_H_
+#define MTAPI_CPP_SRC_TASKBATCH_H_
+
+#include <embb/base/atomic.h>
+#include <embb/mtapi/mtapi.h>
+
+namespace embb {
+namespace mtapi {
+
+/**
+ * Storage shared by all \link Task Tasks \endlink started by one batch
+ * Spawn(). The Actions are copied into a single allocation that follows this
+ * header and freed when the last reference is released.
+ */
+struct TaskBatch {
+  embb::base::Atomic<mtapi_uint_t> references;
+  mtapi_uint_t count;
+};
+
+/**
+ * Arguments of a single Task of a batch.
+ */
+struct TaskBatchEntry {
+  TaskBatchEntry(Action const & entry_action, TaskBatch * entry_batch)
+    : action(entry_action)
+    , batch(entry_batch) {
+    predecessor.id = 0;
+    predecessor.tag = 0;
+  }
+
+  mtapi::Action action;
+  TaskBatch * batch;
+  /**
+   * Finished Task the entry was started after by a Continuation, deleted
+   * when the entry runs. Invalid for the Tasks of a batch Spawn().
+   */
+  mtapi_task_hndl_t predecessor;
+};
+
+/**
+ * Allocates a batch holding copies of \c count Actions. The batch starts
+ * with \c count + 1 references, one for each Task and one for the caller.
+ */
+TaskBatch * TaskBatchCreate(Action const * actions, mtapi_uint_t count);
+
+/**
+ * Returns the entries of a batch.
+ */
+TaskBatchEntry * TaskBatchGetEntries(TaskBatch * batch);
+
+/**
+ * Drops \c references references and frees the batch when none are left.
+ */
+void TaskBatchRelease(TaskBatch * batch, mtapi_uint_t references);
+
+} // namespace mtapi
+} // namespace embb
+
+#endif // MTAPI_CPP_SRC_TASKBATCH_H_
@@ -32,7 +32,15 @@ namespace embb {
 namespace mtapi {
 
 TaskContext::TaskContext(mtapi_task_context_t * task_context)
-  : context_(task_context) {
+  : context_(task_context)
+  , result_buffer_(NULL) {
+}
+
+TaskContext::TaskContext(
+  mtapi_task_context_t * task_context,
+  void * result_buffer)
+  : context_(task_context)
+  , result_buffer_(result_buffer) {
 }
 
 bool TaskContext::ShouldCancel() {
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <cassert>
+#include <vector>
+
+#include <embb/base/memory_allocation.h>
+#include <embb/base/exceptions.h>
+#include <embb/mtapi/mtapi.h>
+
+#include <taskgraphvertex.h>
+
+namespace embb {
+namespace mtapi {
+
+TaskGraph::TaskGraph()
+  : vertices_()
+  , roots_()
+  , validated_(true)
+  , running_(false) {
+  group_ = MTAPI_GROUP_NONE;
+}
+
+TaskGraph::~TaskGraph() {
+  if (running_) {
+    Wait(MTAPI_INFINITE);
+  }
+  for (std::vector<TaskGraphVertex*>::iterator ii = vertices_.begin();
+       ii != vertices_.end();
+       ++ii) {
+    embb::base::Allocation::Delete(*ii);
+  }
+  vertices_.clear();
+}
+
+TaskGraph::VertexId TaskGraph::Add(Action action) {
+  TaskGraphVertex * vertex =
+    embb::base::Allocation::New<TaskGraphVertex>(action);
+  vertices_.push_back(vertex);
+  validated_ = false;
+  return static_cast<VertexId>(vertices_.size() - 1);
+}
+
+void TaskGraph::Precede(VertexId before, VertexId after) {
+  if (before >= vertices_.size() || after >= vertices_.size() ||
+    before == after) {
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::TaskGraph got an invalid dependency");
+  }
+  vertices_[before]->successors.push_back(vertices_[after]);
+  vertices_[after]->predecessors++;
+  validated_ = false;
+}
+
+void TaskGraph::Validate() {
+  // every vertex has to be reachable by removing finished vertices one by
+  // one, otherwise the graph has a cycle
+  std::vector<TaskGraphVertex*> ready;
+  roots_.clear();
+  for (std::vector<TaskGraphVertex*>::iterator ii = vertices_.begin();
+       ii != vertices_.end();
+       ++ii) {
+    (*ii)->pending = (*ii)->predecessors;
+    if (0 == (*ii)->predecessors) {
+      roots_.push_back(*ii);
+      ready.push_back(*ii);
+    }
+  }
+  size_t reached = 0;
+  while (!ready.empty()) {
+    TaskGraphVertex * vertex = ready.back();
+    ready.pop_back();
+    reached++;
+    for (std::vector<TaskGraphVertex*>::iterator ii =
+           vertex->successors.begin();
+         ii != vertex->successors.end();
+         ++ii) {
+      if (1 == (*ii)->pending.FetchAndSub(1)) {
+        ready.push_back(*ii);
+      }
+    }
+  }
+  if (reached != vertices_.size()) {
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::TaskGraph contains a cycle");
+  }
+  validated_ = true;
+}
+
+void TaskGraph::Spawn() {
+  Spawn(0);
+}
+
+void TaskGraph::Spawn(mtapi_uint_t priority) {
+  if (running_) {
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::TaskGraph is running already");
+  }
+  if (!validated_) {
+    Validate();
+  }
+
+  mtapi_status_t status;
+  // a TaskGraph may be the first to use the Node, so it is initialized here
+  // if automatic initialization is enabled
+  mtapi_job_hndl_t job = Node::GetInstance().graph_job_handle_;
+  group_ = mtapi_group_create(MTAPI_GROUP_ID_NONE, MTAPI_NULL, &status);
+  if (MTAPI_SUCCESS != status) {
+    EMBB_THROW(embb::base::ErrorException,
+      "mtapi::TaskGraph could not create a group");
+  }
+
+  // the vertices keep everything their Tasks need, so starting a run does
+  // not allocate
+  for (std::vector<TaskGraphVertex*>::iterator ii = vertices_.begin();
+       ii != vertices_.end();
+       ++ii) {
+    TaskGraphVertex * vertex = *ii;
+    Task::SetAttributes(vertex->action, priority, vertex->attributes);
+    vertex->job = job;
+    vertex->group = group_;
+    vertex->pending = vertex->predecessors;
+  }
+
+  running_ = true;
+  for (std::vector<TaskGraphVertex*>::iterator ii = roots_.begin();
+       ii != roots_.end();
+       ++ii) {
+    if (!Start(*ii)) {
+      // let the roots that were started finish before reporting the error
+      Wait(MTAPI_INFINITE);
+      EMBB_THROW(embb::base::ErrorException,
+        "mtapi::TaskGraph could not be started");
+    }
+  }
+}
+
+mtapi_status_t TaskGraph::Wait(mtapi_timeout_t timeout) {
+  if (!running_) {
+    return MTAPI_SUCCESS;
+  }
+  mtapi_status_t status;
+  mtapi_group_wait_all(group_, timeout, &status);
+  if (MTAPI_TIMEOUT != status) {
+    // the group is deleted once all of its Tasks are collected
+    running_ = false;
+    group_ = MTAPI_GROUP_NONE;
+  }
+  return status;
+}
+
+bool TaskGraph::Start(TaskGraphVertex * vertex) {
+  mtapi_status_t status;
+  mtapi_task_start(MTAPI_TASK_ID_NONE, vertex->job,
+    vertex, sizeof(TaskGraphVertex), MTAPI_NULL, 0, &vertex->attributes,
+    vertex->group, &status);
+  return MTAPI_SUCCESS == status;
+}
+
+void TaskGraph::Run(
+  TaskGraphVertex * vertex,
+  mtapi_task_context_t * context) {
+  TaskContext task_context(context);
+  vertex->action(task_context);
+  // successors are started before this Task finishes, so the group does
+  // not run empty before the whole graph is done
+  for (std::vector<TaskGraphVertex*>::iterator ii =
+         vertex->successors.begin();
+       ii != vertex->successors.end();
+       ++ii) {
+    if (1 == (*ii)->pending.FetchAndSub(1) && !Start(*ii)) {
+      // no Task left, run it right here
+      Run(*ii, context);
+    }
+  }
+}
+
+void TaskGraph::action_func(
+  const void* args,
+  mtapi_size_t /*args_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t * context) {
+  Run(reinterpret_cast<TaskGraphVertex*>(const_cast<void*>(args)), context);
+}
+
+} // namespace mtapi
+} // namespace embb
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MTAPI_CPP_SRC_TASKGRAPHVERTEX_H_
+#define MTAPI_CPP_SRC_TASKGRAPHVERTEX_H_
+
+#include <vector>
+
+#include <embb/base/atomic.h>
+#include <embb/mtapi/mtapi.h>
+
+namespace embb {
+namespace mtapi {
+
+struct TaskGraphVertex {
+  explicit TaskGraphVertex(Action const & vertex_action)
+    : action(vertex_action)
+    , successors()
+    , predecessors(0)
+    , pending(0) {
+    // empty
+  }
+
+  mtapi::Action action;
+  std::vector<TaskGraphVertex*> successors;
+  mtapi_uint_t predecessors;
+  // predecessors that have not finished yet in the current run
+  embb::base::Atomic<mtapi_uint_t> pending;
+  // set up by Spawn() for the current run
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_task_attributes_t attributes;
+};
+
+} // namespace mtapi
+} // namespace embb
+
+#endif // MTAPI_CPP_SRC_TASKGRAPHVERTEX_H_
@@ -31,10 +31,12 @@
 #include <mtapi_cpp_test_task.h>
 #include <mtapi_cpp_test_group.h>
 #include <mtapi_cpp_test_queue.h>
+#include <mtapi_cpp_test_taskgraph.h>
 
 
 PT_MAIN("MTAPI C++") {
   PT_RUN(TaskTest);
   PT_RUN(GroupTest);
   PT_RUN(QueueTest);
+  PT_RUN(TaskGraphTest);
 }
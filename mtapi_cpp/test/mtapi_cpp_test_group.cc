@@ -25,10 +25,13 @@
  */
 
 #include <iostream>
+#include <vector>
 
 #include <mtapi_cpp_test_config.h>
 #include <mtapi_cpp_test_group.h>
 
+#include <embb/base/atomic.h>
+
 struct result_example_struct {
   mtapi_uint_t value1;
   mtapi_uint_t value2;
@@ -44,8 +47,15 @@ static void testGroupAction(embb::mtapi::TaskContext & /*context*/) {
 static void testDoSomethingElse() {
 }
 
+static void testGroupCountAction(
+  embb::mtapi::TaskContext & /*context*/,
+  embb::base::Atomic<int> * counter) {
+  (*counter)++;
+}
+
 GroupTest::GroupTest() {
   CreateUnit("mtapi group test").Add(&GroupTest::TestBasic, this);
+  CreateUnit("mtapi group batch test").Add(&GroupTest::TestBatch, this);
 }
 
 void GroupTest::TestBasic() {
@@ -83,3 +93,31 @@ void GroupTest::TestBasic() {
 
   //std::cout << "...done" << std::endl << std::endl;
 }
+
+void GroupTest::TestBatch() {
+  const mtapi_uint_t count = 100;
+
+  embb::mtapi::Node::Initialize(THIS_DOMAIN_ID, THIS_NODE_ID);
+
+  embb::mtapi::Node & node = embb::mtapi::Node::GetInstance();
+  embb::mtapi::Group & group = node.CreateGroup();
+  embb::base::Atomic<int> counter(0);
+  std::vector<embb::mtapi::Action> actions(count, embb::mtapi::Action(
+    embb::base::Bind(testGroupCountAction, embb::base::Placeholder::_1,
+      &counter)));
+  std::vector<embb::mtapi::Task> tasks(count);
+
+  group.Spawn(&actions[0], count, NULL);
+  PT_EXPECT_EQ(group.WaitAll(MTAPI_INFINITE), MTAPI_SUCCESS);
+  PT_EXPECT_EQ(counter.Load(), static_cast<int>(count));
+
+  node.Spawn(&actions[0], count, &tasks[0]);
+  for (mtapi_uint_t ii = 0; ii < count; ii++) {
+    PT_EXPECT_EQ(tasks[ii].Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+  }
+  PT_EXPECT_EQ(counter.Load(), static_cast<int>(2 * count));
+
+  node.DestroyGroup(group);
+
+  embb::mtapi::Node::Finalize();
+}
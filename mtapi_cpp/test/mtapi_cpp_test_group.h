@@ -35,6 +35,7 @@ class GroupTest : public partest::TestCase {
 
  private:
   void TestBasic();
+  void TestBatch();
 };
 
 #endif // MTAPI_CPP_TEST_MTAPI_CPP_TEST_GROUP_H_
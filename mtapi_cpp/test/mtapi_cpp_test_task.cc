@@ -31,6 +31,9 @@
 #include <mtapi_cpp_test_config.h>
 #include <mtapi_cpp_test_task.h>
 
+#include <embb/base/atomic.h>
+#include <embb/base/thread.h>
+
 #define JOB_TEST_TASK 42
 #define TASK_TEST_ID 23
 
@@ -57,6 +60,14 @@ static void testRecursiveTaskAction(
   PT_EXPECT(*value == 1000);
 }
 
+static void testChainTaskAction(
+  int stage,
+  int * value,
+  embb::mtapi::TaskContext & /*context*/) {
+  PT_EXPECT_EQ(*value, stage);
+  *value = stage + 1;
+}
+
 static void testErrorTaskAction(embb::mtapi::TaskContext & context) {
   context.SetStatus(MTAPI_ERR_ACTION_FAILED);
 }
@@ -64,8 +75,91 @@ static void testErrorTaskAction(embb::mtapi::TaskContext & context) {
 static void testDoSomethingElse() {
 }
 
+static embb::base::Atomic<bool> release_blocked_task;
+
+static void testBlockedTaskAction(embb::mtapi::TaskContext & /*context*/) {
+  while (!release_blocked_task) {
+    embb::base::Thread::CurrentYield();
+  }
+}
+
+static int testFibonacciFuture(
+  int n,
+  embb::mtapi::TaskContext & /*context*/) {
+  if (n < 2) {
+    return n;
+  }
+  embb::mtapi::Node & node = embb::mtapi::Node::GetInstance();
+  embb::mtapi::Future<int> a = node.Spawn<int>(
+    embb::base::Bind(testFibonacciFuture, n - 1, embb::base::Placeholder::_1));
+  embb::mtapi::Future<int> b = node.Spawn<int>(
+    embb::base::Bind(testFibonacciFuture, n - 2, embb::base::Placeholder::_1));
+  return a.Get() + b.Get();
+}
+
+static std::string testStringFuture(embb::mtapi::TaskContext & /*context*/) {
+  return "future";
+}
+
+struct TestLargeResult {
+  double values[32];
+};
+
+static TestLargeResult testLargeFuture(
+  embb::mtapi::TaskContext & /*context*/) {
+  TestLargeResult result;
+  for (int ii = 0; ii < 32; ii++) {
+    result.values[ii] = ii;
+  }
+  return result;
+}
+
+static long double testAlignedFuture(
+  embb::mtapi::TaskContext & /*context*/) {
+  return 2.5L;
+}
+
+static int testErrorFuture(embb::mtapi::TaskContext & context) {
+  context.SetStatus(MTAPI_ERR_ACTION_FAILED);
+  return 0;
+}
+
+static embb::base::Atomic<int> live_counted_results;
+
+struct TestCountedResult {
+  TestCountedResult() {
+    live_counted_results++;
+  }
+  TestCountedResult(TestCountedResult const & /*other*/) {
+    live_counted_results++;
+  }
+  ~TestCountedResult() {
+    live_counted_results--;
+  }
+};
+
+static embb::base::Atomic<bool> cancelled_future_started;
+static embb::base::Atomic<bool> cancelled_future_returned;
+
+static TestCountedResult testCancelledFuture(
+  embb::mtapi::TaskContext & context) {
+  cancelled_future_started = true;
+  while (!context.ShouldCancel()) {
+    embb::base::Thread::CurrentYield();
+  }
+  // keep running a little while after the cancellation
+  for (int ii = 0; ii < 1000; ii++) {
+    embb::base::Thread::CurrentYield();
+  }
+  cancelled_future_returned = true;
+  return TestCountedResult();
+}
+
 TaskTest::TaskTest() {
   CreateUnit("mtapi_cpp task test").Add(&TaskTest::TestBasic, this);
+  CreateUnit("mtapi_cpp task allocation test")
+    .Add(&TaskTest::TestAllocation, this);
+  CreateUnit("mtapi_cpp future test").Add(&TaskTest::TestFuture, this);
 }
 
 void TaskTest::TestBasic() {
@@ -102,6 +196,23 @@ void TaskTest::TestBasic() {
   //std::cout << "result2: " << test2.c_str() << std::endl;
   //std::cout << "result3: " << test3.c_str() << std::endl;
 
+  // the stages of finished chains are recycled, so more of them than fit
+  // into the task pool can run one after the other
+  const int chain_length = 100;
+  for (int chain = 0; chain < 20; chain++) {
+    int stage_value = 0;
+    embb::mtapi::Continuation cont = node.First(
+      embb::base::Bind(
+        testChainTaskAction, 0, &stage_value, embb::base::Placeholder::_1));
+    for (int ii = 1; ii < chain_length; ii++) {
+      cont.Then(embb::base::Bind(
+        testChainTaskAction, ii, &stage_value, embb::base::Placeholder::_1));
+    }
+    task = cont.Spawn();
+    PT_EXPECT_EQ(task.Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+    PT_EXPECT_EQ(stage_value, chain_length);
+  }
+
   int value = 0;
   task = node.Spawn(
     embb::base::Bind(
@@ -119,3 +230,88 @@ void TaskTest::TestBasic() {
 
   //std::cout << "...done" << std::endl << std::endl;
 }
+
+void TaskTest::TestAllocation() {
+  embb::mtapi::Node::Initialize(THIS_DOMAIN_ID, THIS_NODE_ID);
+
+  embb::mtapi::Node & node = embb::mtapi::Node::GetInstance();
+  embb::mtapi::Action action(testBlockedTaskAction);
+
+  // a pending Task holds its Action without allocating memory
+  release_blocked_task = false;
+  size_t allocated = embb::base::Allocation::AllocatedBytes();
+  embb::mtapi::Task task = node.Spawn(action);
+  PT_EXPECT_EQ(embb::base::Allocation::AllocatedBytes(), allocated);
+  release_blocked_task = true;
+  PT_EXPECT_EQ(task.Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+
+  embb::mtapi::Node::Finalize();
+}
+
+void TaskTest::TestFuture() {
+  embb::mtapi::Node::Initialize(THIS_DOMAIN_ID, THIS_NODE_ID);
+
+  embb::mtapi::Node & node = embb::mtapi::Node::GetInstance();
+
+  // the Futures are waited for from within the Tasks
+  embb::mtapi::Future<int> fib = node.Spawn<int>(
+    embb::base::Bind(testFibonacciFuture, 15, embb::base::Placeholder::_1));
+  PT_EXPECT_EQ(fib.Get(), 610);
+
+  embb::mtapi::Future<std::string> text =
+    node.Spawn<std::string>(testStringFuture);
+  PT_EXPECT_EQ(text.Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+  PT_EXPECT(text.Get() == "future");
+
+  // too large to be kept by the task itself
+  embb::mtapi::Future<TestLargeResult> large =
+    node.Spawn<TestLargeResult>(testLargeFuture, 1);
+  TestLargeResult result = large.Get();
+  for (int ii = 0; ii < 32; ii++) {
+    PT_EXPECT_EQ(result.values[ii], static_cast<double>(ii));
+  }
+
+  // may need a stricter alignment than the task storage has
+  embb::mtapi::Future<long double> aligned =
+    node.Spawn<long double>(testAlignedFuture);
+  PT_EXPECT(aligned.Get() == 2.5L);
+
+  embb::mtapi::Future<int> error = node.Spawn<int>(testErrorFuture);
+  PT_EXPECT_EQ(error.Wait(MTAPI_INFINITE), MTAPI_ERR_ACTION_FAILED);
+#ifdef EMBB_USE_EXCEPTIONS
+  bool thrown = false;
+  try {
+    error.Get();
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+#endif // EMBB_USE_EXCEPTIONS
+
+  // the function keeps running after it was cancelled
+  live_counted_results = 0;
+  cancelled_future_started = false;
+  cancelled_future_returned = false;
+  embb::mtapi::Future<TestCountedResult> cancelled =
+    node.Spawn<TestCountedResult>(testCancelledFuture);
+  while (!cancelled_future_started) {
+    embb::base::Thread::CurrentYield();
+  }
+  cancelled.Cancel();
+#ifdef EMBB_USE_EXCEPTIONS
+  thrown = false;
+  try {
+    cancelled.Get();
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+  // the value returned anyway is destroyed
+  PT_EXPECT_EQ(live_counted_results.Load(), 0);
+#else
+  PT_EXPECT_EQ(cancelled.Wait(MTAPI_INFINITE), MTAPI_ERR_ACTION_CANCELLED);
+#endif // EMBB_USE_EXCEPTIONS
+  PT_EXPECT(cancelled_future_returned.Load());
+
+  embb::mtapi::Node::Finalize();
+}
@@ -35,6 +35,8 @@ class TaskTest : public partest::TestCase {
 
  private:
   void TestBasic();
+  void TestAllocation();
+  void TestFuture();
 };
 
 #endif // MTAPI_CPP_TEST_MTAPI_CPP_TEST_TASK_H_
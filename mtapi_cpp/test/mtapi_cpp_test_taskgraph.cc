@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <vector>
+
+#include <mtapi_cpp_test_config.h>
+#include <mtapi_cpp_test_taskgraph.h>
+
+#include <embb/base/atomic.h>
+#include <embb/base/thread.h>
+#include <embb/base/core_set.h>
+
+#define GRAPH_STAGES 20
+#define GRAPH_RUNS 5
+#define GRAPH_TASK_LIMIT 4
+#define GRAPH_FAN_OUT 16
+
+// stores the position at which the stage finished
+static void testGraphStageAction(
+  embb::mtapi::TaskContext & /*context*/,
+  embb::base::Atomic<int> * counter,
+  int * position) {
+  *position = (*counter)++;
+}
+
+static void testGraphCountAction(
+  embb::mtapi::TaskContext & /*context*/,
+  embb::base::Atomic<int> * counter) {
+  (*counter)++;
+}
+
+static void testGraphBlockedAction(
+  embb::mtapi::TaskContext & /*context*/,
+  embb::base::Atomic<bool> * release) {
+  while (!*release) {
+    embb::base::Thread::CurrentYield();
+  }
+}
+
+TaskGraphTest::TaskGraphTest() {
+  CreateUnit("mtapi task graph test").Add(&TaskGraphTest::TestBasic, this);
+  CreateUnit("mtapi task graph error test")
+    .Add(&TaskGraphTest::TestErrors, this);
+  CreateUnit("mtapi task graph task limit test")
+    .Add(&TaskGraphTest::TestTaskLimit, this);
+}
+
+void TaskGraphTest::TestBasic() {
+  embb::mtapi::Node::Initialize(THIS_DOMAIN_ID, THIS_NODE_ID);
+
+  embb::base::Atomic<int> counter(0);
+  int positions[GRAPH_STAGES];
+  std::vector<std::pair<int, int> > edges;
+
+  embb::mtapi::TaskGraph graph;
+  for (int ii = 0; ii < GRAPH_STAGES; ii++) {
+    embb::mtapi::TaskGraph::VertexId id = graph.Add(embb::mtapi::Action(
+      embb::base::Bind(testGraphStageAction, embb::base::Placeholder::_1,
+        &counter, &positions[ii])));
+    PT_EXPECT_EQ(id, static_cast<embb::mtapi::TaskGraph::VertexId>(ii));
+  }
+  // every stage depends on up to two earlier ones, stage 0 starts it all
+  for (int ii = 1; ii < GRAPH_STAGES; ii++) {
+    edges.push_back(std::make_pair((ii - 1) / 2, ii));
+    if (0 == ii % 3) {
+      edges.push_back(std::make_pair(ii - 2, ii));
+    }
+  }
+  for (size_t ii = 0; ii < edges.size(); ii++) {
+    graph.Precede(edges[ii].first, edges[ii].second);
+  }
+
+  for (int run = 0; run < GRAPH_RUNS; run++) {
+    counter = 0;
+    for (int ii = 0; ii < GRAPH_STAGES; ii++) {
+      positions[ii] = -1;
+    }
+
+    graph.Spawn();
+    PT_EXPECT_EQ(graph.Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+
+    PT_EXPECT_EQ(counter.Load(), GRAPH_STAGES);
+    for (size_t ii = 0; ii < edges.size(); ii++) {
+      PT_EXPECT(positions[edges[ii].first] < positions[edges[ii].second]);
+    }
+  }
+
+  embb::mtapi::Node::Finalize();
+}
+
+void TaskGraphTest::TestErrors() {
+#ifdef EMBB_USE_EXCEPTIONS
+  embb::mtapi::Node::Initialize(THIS_DOMAIN_ID, THIS_NODE_ID);
+
+  embb::base::Atomic<int> counter(0);
+  bool thrown;
+
+  // vertex 0 is a root, 1 and 2 wait for each other
+  embb::mtapi::TaskGraph cyclic;
+  for (int ii = 0; ii < 3; ii++) {
+    cyclic.Add(embb::mtapi::Action(embb::base::Bind(testGraphCountAction,
+      embb::base::Placeholder::_1, &counter)));
+  }
+  cyclic.Precede(0, 1);
+  cyclic.Precede(1, 2);
+  cyclic.Precede(2, 1);
+  thrown = false;
+  try {
+    cyclic.Spawn();
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+  // nothing was started
+  PT_EXPECT_EQ(cyclic.Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+  PT_EXPECT_EQ(counter.Load(), 0);
+
+  embb::mtapi::TaskGraph graph;
+  graph.Add(embb::mtapi::Action(embb::base::Bind(testGraphCountAction,
+    embb::base::Placeholder::_1, &counter)));
+
+  thrown = false;
+  try {
+    graph.Precede(0, 1);
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+
+  thrown = false;
+  try {
+    graph.Precede(1, 0);
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+
+  thrown = false;
+  try {
+    graph.Precede(0, 0);
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+
+  // the rejected edges are not part of the graph
+  graph.Spawn();
+  PT_EXPECT_EQ(graph.Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+  PT_EXPECT_EQ(counter.Load(), 1);
+
+  // a running graph cannot be spawned again
+  embb::base::Atomic<bool> release(false);
+  embb::mtapi::TaskGraph blocked;
+  blocked.Add(embb::mtapi::Action(embb::base::Bind(testGraphBlockedAction,
+    embb::base::Placeholder::_1, &release)));
+  blocked.Spawn();
+  thrown = false;
+  try {
+    blocked.Spawn();
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+  release = true;
+  PT_EXPECT_EQ(blocked.Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+
+  embb::mtapi::Node::Finalize();
+#endif // EMBB_USE_EXCEPTIONS
+}
+
+void TaskGraphTest::TestTaskLimit() {
+  // the Tasks of a graph are only released by Wait(), so the pool runs
+  // out of Tasks while the graph is spawned
+  embb::mtapi::Node::Initialize(THIS_DOMAIN_ID, THIS_NODE_ID,
+    embb::base::CoreSet(true), GRAPH_TASK_LIMIT, 4, 4, 64, 4);
+
+  embb::base::Atomic<int> counter(0);
+
+  // the successors that find no Task are run by their predecessor
+  embb::mtapi::TaskGraph fan_out;
+  embb::mtapi::TaskGraph::VertexId root =
+    fan_out.Add(embb::mtapi::Action(embb::base::Bind(testGraphCountAction,
+      embb::base::Placeholder::_1, &counter)));
+  for (int ii = 0; ii < GRAPH_FAN_OUT; ii++) {
+    fan_out.Precede(root,
+      fan_out.Add(embb::mtapi::Action(embb::base::Bind(testGraphCountAction,
+        embb::base::Placeholder::_1, &counter))));
+  }
+  fan_out.Spawn();
+  while (counter.Load() < GRAPH_FAN_OUT + 1) {
+    embb::base::Thread::CurrentYield();
+  }
+  PT_EXPECT_EQ(fan_out.Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+  PT_EXPECT_EQ(counter.Load(), GRAPH_FAN_OUT + 1);
+
+#ifdef EMBB_USE_EXCEPTIONS
+  // roots cannot be run in place, so the graph fails to start
+  counter = 0;
+  embb::mtapi::TaskGraph roots;
+  for (int ii = 0; ii < 2 * GRAPH_TASK_LIMIT; ii++) {
+    roots.Add(embb::mtapi::Action(embb::base::Bind(testGraphCountAction,
+      embb::base::Placeholder::_1, &counter)));
+  }
+  bool thrown = false;
+  try {
+    roots.Spawn();
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+  // the roots that were started have finished, the others never run
+  PT_EXPECT_EQ(roots.Wait(MTAPI_INFINITE), MTAPI_SUCCESS);
+  PT_EXPECT(0 < counter.Load());
+  PT_EXPECT(counter.Load() < 2 * GRAPH_TASK_LIMIT);
+#endif // EMBB_USE_EXCEPTIONS
+
+  embb::mtapi::Node::Finalize();
+}
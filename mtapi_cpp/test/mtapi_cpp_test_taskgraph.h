@@ -24,20 +24,20 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef MTAPI_CPP_SRC_CONTINUATIONSTAGE_H_
-#define MTAPI_CPP_SRC_CONTINUATIONSTAGE_H_
 
-#include <embb/mtapi/mtapi.h>
+#ifndef MTAPI_CPP_TEST_MTAPI_CPP_TEST_TASKGRAPH_H_
+#define MTAPI_CPP_TEST_MTAPI_CPP_TEST_TASKGRAPH_H_
 
-namespace embb {
-namespace mtapi {
+#include <partest/partest.h>
 
-struct ContinuationStage {
-  mtapi::Action action;
-  ContinuationStage * next;
-};
+class TaskGraphTest : public partest::TestCase {
+ public:
+  TaskGraphTest();
 
-} // namespace mtapi
-} // namespace embb
+ private:
+  void TestBasic();
+  void TestErrors();
+  void TestTaskLimit();
+};
 
-#endif // MTAPI_CPP_SRC_CONTINUATIONSTAGE_H_
+#endif // MTAPI_CPP_TEST_MTAPI_CPP_TEST_TASKGRAPH_H_